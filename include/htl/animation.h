@@ -0,0 +1,336 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <span>
+
+namespace hrzn {
+
+	/// <summary>
+	/// Structure-of-arrays storage for many transforms. Each component is kept in its own contiguous list so batch
+	/// operations can stream over them.
+	/// </summary>
+	struct hTransformBatch {
+		std::vector<hType_f> x, y;
+		std::vector<hType_f> tau;
+		std::vector<hType_f> scale_x, scale_y;
+
+		hTransformBatch() {}
+		explicit hTransformBatch(std::size_t n) { resize(n); }
+
+		std::size_t size() const { return x.size(); }
+
+		void resize(std::size_t n) {
+			x.resize(n, 0._hf);
+			y.resize(n, 0._hf);
+			tau.resize(n, 0._hf);
+			scale_x.resize(n, 1._hf);
+			scale_y.resize(n, 1._hf);
+		}
+
+		hTransform get(std::size_t i) const {
+			return { { x[i], y[i] }, hRotation(tau[i]), { scale_x[i], scale_y[i] } };
+		}
+
+		void set(std::size_t i, const hTransform& tform) {
+			x[i] = tform.position.x;
+			y[i] = tform.position.y;
+			tau[i] = tform.rotation.tau;
+			scale_x[i] = tform.scale.x;
+			scale_y[i] = tform.scale.y;
+		}
+
+		void push_back(const hTransform& tform) {
+			resize(size() + 1);
+			set(size() - 1, tform);
+		}
+
+	}; // struct hTransformBatch
+
+
+	namespace ease {
+		inline hType_f linear(hType_f f) { return f; }
+		inline hType_f smoothstep(hType_f f) { return f * f * (3._hf - 2._hf * f); }
+		inline hType_f smootherstep(hType_f f) { return f * f * f * (f * (6._hf * f - 15._hf) + 10._hf); }
+	} // namespace ease
+
+
+	namespace lerp {
+
+		/// <summary>
+		/// Interpolate two lists of scalars with a separate factor for every element.
+		/// The loops are branch free and operate on plain arrays so that the compiler can vectorize them.
+		/// </summary>
+		template <typename TEase>
+		inline void interpolate(std::span<const hType_f> a, std::span<const hType_f> b, std::span<const hType_f> f, std::span<hType_f> out, TEase ease) {
+			assert(b.size() >= a.size() && f.size() >= a.size() && out.size() >= a.size());
+			const hType_f* pa = a.data();
+			const hType_f* pb = b.data();
+			const hType_f* pf = f.data();
+			hType_f* po = out.data();
+			const std::size_t n = a.size();
+			for (std::size_t i = 0; i < n; ++i) {
+				const hType_f t = ease(pf[i]);
+				po[i] = (pa[i] * (1._hf - t)) + (pb[i] * t);
+			}
+		}
+
+		/// <summary>
+		/// Interpolate two lists of rotations (in turns) along the shortest path between each pair.
+		/// </summary>
+		template <typename TEase>
+		inline void interpolateAngle(std::span<const hType_f> a, std::span<const hType_f> b, std::span<const hType_f> f, std::span<hType_f> out, TEase ease) {
+			assert(b.size() >= a.size() && f.size() >= a.size() && out.size() >= a.size());
+			const hType_f* pa = a.data();
+			const hType_f* pb = b.data();
+			const hType_f* pf = f.data();
+			hType_f* po = out.data();
+			const std::size_t n = a.size();
+			for (std::size_t i = 0; i < n; ++i) {
+				const hType_f t = ease(pf[i]);
+				hType_f d = pb[i] - pa[i];
+				d -= std::floor(d + 0.5_hf);
+				po[i] = pa[i] + d * t;
+			}
+		}
+
+		template <typename TEase>
+		inline void interpolate(std::span<const hVector> a, std::span<const hVector> b, std::span<const hType_f> f, std::span<hVector> out, TEase ease) {
+			assert(b.size() >= a.size() && f.size() >= a.size() && out.size() >= a.size());
+			const std::size_t n = a.size();
+			for (std::size_t i = 0; i < n; ++i) {
+				const hType_f t = ease(f[i]);
+				out[i].x = (a[i].x * (1._hf - t)) + (b[i].x * t);
+				out[i].y = (a[i].y * (1._hf - t)) + (b[i].y * t);
+			}
+		}
+
+		template <typename TEase>
+		inline void interpolate(const hTransformBatch& a, const hTransformBatch& b, std::span<const hType_f> f, hTransformBatch& out, TEase ease) {
+			assert(b.size() >= a.size());
+			if (out.size() < a.size())
+				out.resize(a.size());
+			interpolate(a.x, b.x, f, out.x, ease);
+			interpolate(a.y, b.y, f, out.y, ease);
+			interpolateAngle(a.tau, b.tau, f, out.tau, ease);
+			interpolate(a.scale_x, b.scale_x, f, out.scale_x, ease);
+			interpolate(a.scale_y, b.scale_y, f, out.scale_y, ease);
+		}
+
+		inline void lerp(std::span<const hType_f> a, std::span<const hType_f> b, std::span<const hType_f> f, std::span<hType_f> out) {
+			interpolate(a, b, f, out, ease::linear);
+		}
+
+		inline void lerp(std::span<const hVector> a, std::span<const hVector> b, std::span<const hType_f> f, std::span<hVector> out) {
+			interpolate(a, b, f, out, ease::linear);
+		}
+
+		inline void lerp(const hTransformBatch& a, const hTransformBatch& b, std::span<const hType_f> f, hTransformBatch& out) {
+			interpolate(a, b, f, out, ease::linear);
+		}
+
+		inline void lerpAngle(std::span<const hType_f> a, std::span<const hType_f> b, std::span<const hType_f> f, std::span<hType_f> out) {
+			interpolateAngle(a, b, f, out, ease::linear);
+		}
+
+		inline void smoothstep(std::span<const hVector> a, std::span<const hVector> b, std::span<const hType_f> f, std::span<hVector> out) {
+			interpolate(a, b, f, out, ease::smoothstep);
+		}
+
+		inline void smoothstep(const hTransformBatch& a, const hTransformBatch& b, std::span<const hType_f> f, hTransformBatch& out) {
+			interpolate(a, b, f, out, ease::smoothstep);
+		}
+
+		inline void smootherstep(std::span<const hVector> a, std::span<const hVector> b, std::span<const hType_f> f, std::span<hVector> out) {
+			interpolate(a, b, f, out, ease::smootherstep);
+		}
+
+		inline void smootherstep(const hTransformBatch& a, const hTransformBatch& b, std::span<const hType_f> f, hTransformBatch& out) {
+			interpolate(a, b, f, out, ease::smootherstep);
+		}
+
+	} // namespace lerp
+
+	/// <summary>
+	/// Interpolation methods available for sampling keyframe tracks.
+	/// </summary>
+	enum class hInterpolation {
+		Step,
+		Linear,
+		Smoothstep,
+		CatmullRom,
+		Hermite
+	};
+
+
+	/// <summary>
+	/// Per-instance playback state of a track. Remembers the last keyframe segment so that sampling with
+	/// increasing times only needs to step forward instead of searching.
+	/// </summary>
+	struct hTrackCursor {
+		std::size_t key = 0;
+	};
+
+
+	/// <summary>
+	/// A keyframed transform track. Times are sorted and keyframe values are stored as a structure of arrays.
+	/// </summary>
+	struct hTransformTrack {
+		std::vector<hType_f> times;
+		hTransformBatch keys;
+		hTransformBatch tangents;
+		hInterpolation mode = hInterpolation::Linear;
+
+		hTransformTrack() {}
+		explicit hTransformTrack(hInterpolation interpolation) : mode(interpolation) {}
+
+		std::size_t size() const { return times.size(); }
+
+		hType_f duration() const { return times.empty() ? 0._hf : times.back() - times.front(); }
+
+		/// <summary>
+		/// Append a keyframe. Keyframes must be added in increasing time order.
+		/// </summary>
+		/// <param name="tangent">Rate of change per unit of time, only used by <c>hInterpolation::Hermite</c>.</param>
+		void add(hType_f time, const hTransform& value, const hTransform& tangent = hTransform({ 0._hf, 0._hf }, 0._hf, { 0._hf, 0._hf })) {
+			if (!times.empty() && time <= times.back())
+				throw std::invalid_argument("Keyframes must be added in increasing time order.");
+			times.push_back(time);
+			keys.push_back(value);
+			tangents.push_back(tangent);
+		}
+
+		/// <summary>
+		/// Find the keyframe segment containing a time, starting from the segment cached in the cursor.
+		/// </summary>
+		/// <returns>Index of the first keyframe of the segment.</returns>
+		std::size_t locate(hType_f t, hTrackCursor& cursor) const {
+			const std::size_t n = times.size();
+			if (n < 2 || t <= times[0])
+				return cursor.key = 0;
+			if (t >= times[n - 1])
+				return cursor.key = n - 1;
+
+			std::size_t k = std::min(cursor.key, n - 2);
+			if (t >= times[k]) {
+				// Walk forward a few segments before giving up on the cache.
+				for (int step = 0; step < 4; ++step) {
+					if (t < times[k + 1])
+						return cursor.key = k;
+					++k;
+				}
+			}
+			auto it = std::upper_bound(times.begin(), times.end(), t);
+			return cursor.key = static_cast<std::size_t>(it - times.begin()) - 1;
+		}
+
+		hTransform sample(hType_f t) const {
+			hTrackCursor cursor;
+			return sample(t, cursor);
+		}
+
+		hTransform sample(hType_f t, hTrackCursor& cursor) const {
+			if (times.empty())
+				return hTransform();
+			std::size_t k = locate(t, cursor);
+			if (k + 1 >= times.size())
+				return keys.get(k);
+			hType_f dt = times[k + 1] - times[k];
+			hType_f s = (t - times[k]) / dt;
+			return {
+				{ channel(keys.x, tangents.x, k, s, dt, false), channel(keys.y, tangents.y, k, s, dt, false) },
+				hRotation(channel(keys.tau, tangents.tau, k, s, dt, true)),
+				{ channel(keys.scale_x, tangents.scale_x, k, s, dt, false), channel(keys.scale_y, tangents.scale_y, k, s, dt, false) }
+			};
+		}
+
+		/// <summary>
+		/// Evaluate a single component of the track within segment <paramref name="k"/> at local position <paramref name="s"/>.
+		/// </summary>
+		hType_f channel(const std::vector<hType_f>& v, const std::vector<hType_f>& tan, std::size_t k, hType_f s, hType_f dt, bool angle) const {
+			const hType_f p0 = v[k];
+			hType_f d = v[k + 1] - p0;
+			if (angle)
+				d -= std::floor(d + 0.5_hf);
+			const hType_f p1 = p0 + d;
+
+			switch (mode) {
+			case hInterpolation::Step:
+				return p0;
+			case hInterpolation::Linear:
+				return p0 + d * s;
+			case hInterpolation::Smoothstep:
+				return p0 + d * ease::smoothstep(s);
+			default:
+				break;
+			}
+
+			hType_f m0, m1;
+			if (mode == hInterpolation::Hermite) {
+				m0 = tan[k] * dt;
+				m1 = tan[k + 1] * dt;
+			}
+			else {
+				// Catmull-Rom tangents from neighbouring keys, scaled for uneven keyframe spacing.
+				const std::size_t last = times.size() - 1;
+				std::size_t a = k > 0 ? k - 1 : k;
+				std::size_t b = k + 2 <= last ? k + 2 : k + 1;
+				hType_f da = p0 - v[a];
+				hType_f db = v[b] - v[k + 1];
+				if (angle) {
+					da -= std::floor(da + 0.5_hf);
+					db -= std::floor(db + 0.5_hf);
+				}
+				m0 = (d + da) / (times[k + 1] - times[a]) * dt;
+				m1 = (db + d) / (times[b] - times[k]) * dt;
+			}
+
+			const hType_f s2 = s * s;
+			const hType_f s3 = s2 * s;
+			return (2._hf * s3 - 3._hf * s2 + 1._hf) * p0 + (s3 - 2._hf * s2 + s) * m0 + (-2._hf * s3 + 3._hf * s2) * p1 + (s3 - s2) * m1;
+		}
+
+	}; // struct hTransformTrack
+
+
+	/// <summary>
+	/// Sample many tracks in one pass. Every track is advanced with its own cursor and sample time, then the results
+	/// are written into a structure of arrays.
+	/// </summary>
+	/// <param name="tracks">List of tracks to sample.</param>
+	/// <param name="cursors">One cursor per track.</param>
+	/// <param name="t">One sample time per track.</param>
+	/// <param name="out">Receives one transform per track.</param>
+	inline void sampleTracks(std::span<const hTransformTrack> tracks, std::span<hTrackCursor> cursors, std::span<const hType_f> t, hTransformBatch& out) {
+		assert(cursors.size() >= tracks.size() && t.size() >= tracks.size());
+		if (out.size() < tracks.size())
+			out.resize(tracks.size());
+		for (std::size_t i = 0; i < tracks.size(); ++i)
+			out.set(i, tracks[i].sample(t[i], cursors[i]));
+	}
+
+} // namespace hrzn
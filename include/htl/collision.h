@@ -0,0 +1,714 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <limits>
+
+namespace hrzn {
+
+	/// <summary>
+	/// Result of a collision test between two convex shapes.
+	/// </summary>
+	struct hContact {
+		bool hit = false;
+		/// Unit vector pointing from the first shape toward the second.
+		hVector normal;
+		hType_f depth = 0._hf;
+		hVector points[2];
+		std::size_t count = 0;
+
+		explicit operator bool() const { return hit; }
+
+		/// Translation which separates the second shape from the first.
+		hVector penetration() const { return normal * depth; }
+
+	}; // struct hContact
+
+
+	/// <summary>
+	/// An oriented box stored as a center, a unit x axis, and half extents. Used as the precomputed form of an <c>hQuad</c>.
+	/// </summary>
+	struct hOBB {
+		hVector center;
+		hVector axis;
+		hVector half;
+
+		constexpr hOBB() : center(0._hf, 0._hf), axis(1._hf, 0._hf), half(0.5_hf, 0.5_hf) {}
+
+		constexpr hOBB(hVector c, hVector a, hVector h) : center(c), axis(a), half(h) {}
+
+		explicit hOBB(const hQuad& quad) : center(quad.position), axis(quad.rotation.getForwardVector()), half(abs(quad.scale) * 0.5_hf) {}
+
+		hVector axisY() const { return { -axis.y, axis.x }; }
+
+		/// Get the corners in the same order as <c>h_quad</c>.
+		hVector corner(std::size_t i) const {
+			hType_f sx = h_quad[i].x * 2._hf - 1._hf;
+			hType_f sy = h_quad[i].y * 2._hf - 1._hf;
+			return center + axis * (sx * half.x) + axisY() * (sy * half.y);
+		}
+
+	}; // struct hOBB
+
+
+	/// <summary>
+	/// Structure-of-arrays storage for oriented boxes, used by the batch collision test.
+	/// </summary>
+	struct hOBBBatch {
+		std::vector<hType_f> cx, cy;
+		std::vector<hType_f> ax, ay;
+		std::vector<hType_f> hx, hy;
+
+		std::size_t size() const { return cx.size(); }
+
+		void reserve(std::size_t n) {
+			cx.reserve(n); cy.reserve(n);
+			ax.reserve(n); ay.reserve(n);
+			hx.reserve(n); hy.reserve(n);
+		}
+
+		void push_back(const hOBB& box) {
+			cx.push_back(box.center.x); cy.push_back(box.center.y);
+			ax.push_back(box.axis.x); ay.push_back(box.axis.y);
+			hx.push_back(box.half.x); hy.push_back(box.half.y);
+		}
+
+		hOBB get(std::size_t i) const {
+			return { { cx[i], cy[i] }, { ax[i], ay[i] }, { hx[i], hy[i] } };
+		}
+
+	}; // struct hOBBBatch
+
+
+	namespace collision {
+
+		inline hType_f dot(hVector a, hVector b) { return a.x * b.x + a.y * b.y; }
+
+		/// Outward unit normal of edge <paramref name="i"/> for a polygon with the given winding sign.
+		/// A zero length edge, left by a repeated vertex, has a zero normal.
+		inline hVector edgeNormal(hPolygonView poly, std::size_t i, hType_f winding) {
+			hVector e = poly[(i + 1) % poly.count()] - poly[i];
+			return hVector(e.y * winding, -e.x * winding).normal();
+		}
+
+		/// <summary>
+		/// Build the contact points by clipping the incident edge against the side planes of the reference edge.
+		/// </summary>
+		/// <param name="r1">First vertex of the reference edge.</param>
+		/// <param name="r2">Second vertex of the reference edge.</param>
+		/// <param name="ref_normal">Outward normal of the reference edge.</param>
+		/// <param name="i1">First vertex of the incident edge.</param>
+		/// <param name="i2">Second vertex of the incident edge.</param>
+		inline void clipManifold(hVector r1, hVector r2, hVector ref_normal, hVector i1, hVector i2, hContact& contact) {
+			hVector tangent = (r2 - r1).normal();
+			hVector pts[2] = { i1, i2 };
+			std::size_t n = 2;
+
+			const hType_f offsets[2] = { -dot(tangent, r1), dot(tangent, r2) };
+			const hVector planes[2] = { tangent, -tangent };
+			for (int p = 0; p < 2 && n == 2; ++p) {
+				hType_f d0 = dot(planes[p], pts[0]) + offsets[p];
+				hType_f d1 = dot(planes[p], pts[1]) + offsets[p];
+				if (d0 < 0._hf && d1 < 0._hf) {
+					n = 0;
+				}
+				else if (d0 < 0._hf) {
+					pts[0] = pts[0] + (pts[1] - pts[0]) * (d0 / (d0 - d1));
+				}
+				else if (d1 < 0._hf) {
+					pts[1] = pts[0] + (pts[1] - pts[0]) * (d0 / (d0 - d1));
+				}
+			}
+
+			contact.count = 0;
+			for (std::size_t i = 0; i < n; ++i)
+				if (dot(ref_normal, pts[i] - r1) <= H_EPSILON)
+					contact.points[contact.count++] = pts[i];
+
+			// Numerical fallback, use the deepest point of the incident edge.
+			if (contact.count == 0)
+				contact.points[contact.count++] = dot(ref_normal, i1 - r1) < dot(ref_normal, i2 - r1) ? i1 : i2;
+		}
+
+		/// <summary>
+		/// Find the edge of <paramref name="a"/> which best separates it from <paramref name="b"/>.
+		/// </summary>
+		/// <returns>The separation distance, which is negative when the shapes overlap. Zero length edges are skipped,
+		/// and a polygon without any proper edge is reported as separated.</returns>
+		inline hType_f maxSeparation(hPolygonView a, hType_f wa, hPolygonView b, std::size_t& edge) {
+			hType_f best = -std::numeric_limits<hType_f>::max();
+			edge = a.count();
+			for (std::size_t i = 0; i < a.count(); ++i) {
+				hVector n = edgeNormal(a, i, wa);
+				if (n.x == 0._hf && n.y == 0._hf)
+					continue;
+				hType_f sep = std::numeric_limits<hType_f>::max();
+				for (const hVector& v : b.vertices)
+					sep = std::min(sep, dot(n, v - a[i]));
+				if (sep > best) {
+					best = sep;
+					edge = i;
+				}
+			}
+			return edge < a.count() ? best : std::numeric_limits<hType_f>::max();
+		}
+
+		/// <summary>
+		/// Separating axis test between two convex polygons of any winding. Reports the penetration and up to two contact points.
+		/// Polygons which only touch are not reported as a hit, matching the box test.
+		/// </summary>
+		inline hContact collide(hPolygonView a, hPolygonView b) {
+			hContact contact;
+			if (a.count() < 3 || b.count() < 3)
+				return contact;
+
+			hType_f wa = polygon::signedArea(a) < 0._hf ? -1._hf : 1._hf;
+			hType_f wb = polygon::signedArea(b) < 0._hf ? -1._hf : 1._hf;
+
+			std::size_t edge_a, edge_b;
+			hType_f sep_a = maxSeparation(a, wa, b, edge_a);
+			if (sep_a >= 0._hf)
+				return contact;
+			hType_f sep_b = maxSeparation(b, wb, a, edge_b);
+			if (sep_b >= 0._hf)
+				return contact;
+
+			// Prefer the first polygon as the reference to keep results stable between frames.
+			bool flip = sep_b > sep_a + 0.001_hf;
+			hPolygonView ref = flip ? b : a;
+			hPolygonView inc = flip ? a : b;
+			hType_f w_ref = flip ? wb : wa;
+			hType_f w_inc = flip ? wa : wb;
+			std::size_t ref_edge = flip ? edge_b : edge_a;
+			hVector ref_normal = edgeNormal(ref, ref_edge, w_ref);
+
+			std::size_t inc_edge = 0;
+			hType_f min_dot = std::numeric_limits<hType_f>::max();
+			for (std::size_t i = 0; i < inc.count(); ++i) {
+				hVector n = edgeNormal(inc, i, w_inc);
+				if (n.x == 0._hf && n.y == 0._hf)
+					continue;
+				hType_f d = dot(ref_normal, n);
+				if (d < min_dot) {
+					min_dot = d;
+					inc_edge = i;
+				}
+			}
+
+			contact.hit = true;
+			contact.depth = -(flip ? sep_b : sep_a);
+			contact.normal = flip ? -ref_normal : ref_normal;
+			clipManifold(ref[ref_edge], ref[(ref_edge + 1) % ref.count()], ref_normal, inc[inc_edge], inc[(inc_edge + 1) % inc.count()], contact);
+			return contact;
+		}
+
+		inline hContact collide(const IPolygon& a, const IPolygon& b) {
+			std::vector<hVector> va(a.count());
+			std::vector<hVector> vb(b.count());
+			return collide(a.view(va), b.view(vb));
+		}
+
+		/// <summary>
+		/// Fill in the contact points of two overlapping boxes.
+		/// </summary>
+		/// <param name="axis">Index of the separating axis with the least overlap: 0 and 1 for the axes of <paramref name="a"/>, 2 and 3 for <paramref name="b"/>.</param>
+		inline void boxManifold(const hOBB& a, const hOBB& b, int axis, hContact& contact) {
+			const hOBB& ref = axis < 2 ? a : b;
+			const hOBB& inc = axis < 2 ? b : a;
+			hVector ref_normal = axis < 2 ? contact.normal : -contact.normal;
+
+			// Outward normals of the box edges, in the same order as the corners.
+			const hVector ref_normals[4] = { -ref.axisY(), ref.axis, ref.axisY(), -ref.axis };
+			const hVector inc_normals[4] = { -inc.axisY(), inc.axis, inc.axisY(), -inc.axis };
+
+			std::size_t ref_edge = 0, inc_edge = 0;
+			hType_f max_dot = -std::numeric_limits<hType_f>::max();
+			hType_f min_dot = std::numeric_limits<hType_f>::max();
+			for (std::size_t i = 0; i < 4; ++i) {
+				hType_f dr = dot(ref_normals[i], ref_normal);
+				hType_f di = dot(inc_normals[i], ref_normal);
+				if (dr > max_dot) { max_dot = dr; ref_edge = i; }
+				if (di < min_dot) { min_dot = di; inc_edge = i; }
+			}
+
+			clipManifold(ref.corner(ref_edge), ref.corner((ref_edge + 1) % 4), ref_normals[ref_edge], inc.corner(inc_edge), inc.corner((inc_edge + 1) % 4), contact);
+		}
+
+		/// <summary>
+		/// Compute the overlap of two boxes along the four candidate axes and keep the smallest.
+		/// </summary>
+		/// <returns>Index of the axis with the least overlap. The overlap is not positive when the boxes are separated.</returns>
+		inline int boxOverlap(hType_f acx, hType_f acy, hType_f aax, hType_f aay, hType_f ahx, hType_f ahy,
+			hType_f bcx, hType_f bcy, hType_f bax, hType_f bay, hType_f bhx, hType_f bhy,
+			hType_f& overlap, hVector& normal) {
+
+			const hType_f dx = bcx - acx;
+			const hType_f dy = bcy - acy;
+
+			// Rotation of b relative to a.
+			const hType_f c = std::abs(aax * bax + aay * bay);
+			const hType_f s = std::abs(aax * bay - aay * bax);
+
+			const hType_f da[2] = { aax * dx + aay * dy, -aay * dx + aax * dy };
+			const hType_f db[2] = { bax * dx + bay * dy, -bay * dx + bax * dy };
+			const hType_f o[4] = {
+				ahx + bhx * c + bhy * s - std::abs(da[0]),
+				ahy + bhx * s + bhy * c - std::abs(da[1]),
+				bhx + ahx * c + ahy * s - std::abs(db[0]),
+				bhy + ahx * s + ahy * c - std::abs(db[1])
+			};
+
+			int axis = 0;
+			for (int i = 1; i < 4; ++i)
+				axis = o[i] < o[axis] ? i : axis;
+
+			const hVector axes[4] = { { aax, aay }, { -aay, aax }, { bax, bay }, { -bay, bax } };
+			const hType_f dist[4] = { da[0], da[1], db[0], db[1] };
+			overlap = o[axis];
+			normal = dist[axis] < 0._hf ? -axes[axis] : axes[axis];
+			return axis;
+		}
+
+		/// <summary>
+		/// Fast separating axis test between two oriented boxes using their precomputed axes.
+		/// </summary>
+		inline hContact collide(const hOBB& a, const hOBB& b) {
+			hContact contact;
+			hType_f overlap;
+			int axis = boxOverlap(a.center.x, a.center.y, a.axis.x, a.axis.y, a.half.x, a.half.y,
+				b.center.x, b.center.y, b.axis.x, b.axis.y, b.half.x, b.half.y, overlap, contact.normal);
+			if (overlap <= 0._hf)
+				return contact;
+			contact.hit = true;
+			contact.depth = overlap;
+			boxManifold(a, b, axis, contact);
+			return contact;
+		}
+
+		inline hContact collide(const hQuad& a, const hQuad& b) {
+			return collide(hOBB(a), hOBB(b));
+		}
+
+		/// <summary>
+		/// Test a list of broadphase pairs. The overlap of every pair is computed first in a single pass over the box
+		/// arrays, then contact points are generated only for the pairs which actually collide.
+		/// </summary>
+		/// <param name="boxes">Boxes referenced by the pair lists.</param>
+		/// <param name="first">Index of the first box of each pair.</param>
+		/// <param name="second">Index of the second box of each pair.</param>
+		/// <param name="out">Receives one contact per pair.</param>
+		inline void collide(const hOBBBatch& boxes, std::span<const std::uint32_t> first, std::span<const std::uint32_t> second, std::span<hContact> out) {
+			assert(second.size() >= first.size() && out.size() >= first.size());
+			const std::size_t n = first.size();
+			const hType_f* cx = boxes.cx.data();
+			const hType_f* cy = boxes.cy.data();
+			const hType_f* ax = boxes.ax.data();
+			const hType_f* ay = boxes.ay.data();
+			const hType_f* hx = boxes.hx.data();
+			const hType_f* hy = boxes.hy.data();
+
+			// The axis index is kept in the contact count until the manifold is generated.
+			for (std::size_t i = 0; i < n; ++i) {
+				const std::uint32_t a = first[i];
+				const std::uint32_t b = second[i];
+				hContact& c = out[i];
+				c.count = static_cast<std::size_t>(boxOverlap(cx[a], cy[a], ax[a], ay[a], hx[a], hy[a], cx[b], cy[b], ax[b], ay[b], hx[b], hy[b], c.depth, c.normal));
+				c.hit = c.depth > 0._hf;
+			}
+
+			for (std::size_t i = 0; i < n; ++i) {
+				hContact& c = out[i];
+				if (c.hit) {
+					boxManifold(boxes.get(first[i]), boxes.get(second[i]), static_cast<int>(c.count), c);
+				}
+				else {
+					c.count = 0;
+					c.depth = 0._hf;
+				}
+			}
+		}
+
+
+		/******************************************************************************************************************
+			Point containment queries
+		******************************************************************************************************************/
+
+		/// Number of 64 bit words needed to store a bitmask for <paramref name="n"/> points.
+		constexpr std::size_t maskWords(std::size_t n) { return (n + 63) / 64; }
+
+		inline bool maskTest(std::span<const std::uint64_t> mask, std::size_t i) {
+			return (mask[i / 64] >> (i % 64)) & 1u;
+		}
+
+		/// Winding contribution of the edge from <paramref name="a"/> to <paramref name="b"/> around point (<paramref name="px"/>, <paramref name="py"/>).
+		inline int edgeWinding(hVector a, hVector b, hType_f px, hType_f py) {
+			const hType_f side = (b.x - a.x) * (py - a.y) - (px - a.x) * (b.y - a.y);
+			const int up = (a.y <= py) & (b.y > py) & (side > 0._hf);
+			const int down = (a.y > py) & (b.y <= py) & (side < 0._hf);
+			return up - down;
+		}
+
+		/// <summary>
+		/// Find the winding number of a polygon around a point. The point is inside when the result is not zero.
+		/// </summary>
+		inline int winding(hPolygonView poly, hVector pt) {
+			const std::size_t n = poly.count();
+			int w = 0;
+			for (std::size_t i = 0, j = n - 1; i < n; j = i++)
+				w += edgeWinding(poly[j], poly[i], pt.x, pt.y);
+			return w;
+		}
+
+		/// <summary>
+		/// Test many points against one polygon using the non-zero winding rule.
+		/// Points are processed in blocks with the edge loop outside, so the inner loop runs branch free across points.
+		/// </summary>
+		/// <param name="mask">Receives one bit per point. Must hold at least <c>maskWords(points.size())</c> words.</param>
+		inline void contains(hPolygonView poly, std::span<const hVector> points, std::span<std::uint64_t> mask) {
+			assert(mask.size() >= maskWords(points.size()));
+			constexpr std::size_t block = 256;
+			const std::size_t n = poly.count();
+			int w[block];
+
+			for (std::size_t first = 0; first < points.size(); first += block) {
+				const std::size_t count = std::min(block, points.size() - first);
+				const hVector* pts = points.data() + first;
+				std::fill(w, w + count, 0);
+
+				for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+					const hVector a = poly[j];
+					const hVector b = poly[i];
+					for (std::size_t k = 0; k < count; ++k)
+						w[k] += edgeWinding(a, b, pts[k].x, pts[k].y);
+				}
+
+				for (std::size_t k = 0; k < count; k += 64) {
+					std::uint64_t bits = 0;
+					const std::size_t end = std::min<std::size_t>(64, count - k);
+					for (std::size_t b = 0; b < end; ++b)
+						bits |= static_cast<std::uint64_t>(w[k + b] != 0) << b;
+					mask[(first + k) / 64] = bits;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Test many points against an area. Writes one bit per point.
+		/// </summary>
+		template <typename T>
+		inline void contains(const hArea& area, std::span<const ITuple<T>> points, std::span<std::uint64_t> mask) {
+			assert(mask.size() >= maskWords(points.size()));
+			const T x1 = static_cast<T>(area.x1), y1 = static_cast<T>(area.y1), x2 = static_cast<T>(area.x2), y2 = static_cast<T>(area.y2);
+			for (std::size_t first = 0; first < points.size(); first += 64) {
+				const std::size_t end = std::min<std::size_t>(64, points.size() - first);
+				const ITuple<T>* pts = points.data() + first;
+				std::uint64_t bits = 0;
+				for (std::size_t b = 0; b < end; ++b) {
+					const std::uint64_t in = (pts[b].x >= x1) & (pts[b].x < x2) & (pts[b].y >= y1) & (pts[b].y < y2);
+					bits |= in << b;
+				}
+				mask[first / 64] = bits;
+			}
+		}
+
+		inline void contains(const hArea& area, std::span<const hPoint> points, std::span<std::uint64_t> mask) {
+			contains<hType_i>(area, points, mask);
+		}
+
+		inline void contains(const hArea& area, std::span<const hVector> points, std::span<std::uint64_t> mask) {
+			contains<hType_f>(area, points, mask);
+		}
+
+	} // namespace collision
+
+
+	/// <summary>
+	/// Acceleration structure for point queries against polygons with many vertices. The polygon is cut into
+	/// horizontal slabs at every vertex height, and each slab keeps only the edges which cross it, so a query
+	/// costs a binary search plus the few edges of a single slab.
+	/// </summary>
+	struct hPolygonSlabs {
+		std::vector<hType_f> heights;
+		std::vector<std::size_t> offsets;
+		std::vector<hVector> edges;
+
+		hPolygonSlabs() {}
+
+		explicit hPolygonSlabs(hPolygonView poly) { build(poly); }
+
+		void build(hPolygonView poly) {
+			const std::size_t n = poly.count();
+			heights.clear();
+			offsets.clear();
+			edges.clear();
+			for (const hVector& v : poly.vertices)
+				heights.push_back(v.y);
+			std::sort(heights.begin(), heights.end());
+			heights.erase(std::unique(heights.begin(), heights.end()), heights.end());
+			if (heights.size() < 2)
+				return;
+
+			// Count the edges crossing each slab, then fill them in a second pass.
+			const std::size_t slabs = heights.size() - 1;
+			std::vector<std::size_t> counts(slabs + 1, 0);
+			auto range = [&](hVector a, hVector b) {
+				hType_f lo = std::min(a.y, b.y);
+				hType_f hi = std::max(a.y, b.y);
+				std::size_t s1 = std::lower_bound(heights.begin(), heights.end(), lo) - heights.begin();
+				std::size_t s2 = std::lower_bound(heights.begin(), heights.end(), hi) - heights.begin();
+				return std::make_pair(s1, s2);
+			};
+			for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+				auto [s1, s2] = range(poly[j], poly[i]);
+				for (std::size_t s = s1; s < s2; ++s)
+					counts[s + 1]++;
+			}
+			for (std::size_t s = 0; s < slabs; ++s)
+				counts[s + 1] += counts[s];
+			offsets = counts;
+			edges.resize(offsets.back() * 2);
+			for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+				auto [s1, s2] = range(poly[j], poly[i]);
+				for (std::size_t s = s1; s < s2; ++s) {
+					edges[counts[s] * 2] = poly[j];
+					edges[counts[s] * 2 + 1] = poly[i];
+					counts[s]++;
+				}
+			}
+		}
+
+		int winding(hVector pt) const {
+			if (heights.size() < 2 || pt.y < heights.front() || pt.y >= heights.back())
+				return 0;
+			std::size_t s = std::upper_bound(heights.begin(), heights.end(), pt.y) - heights.begin() - 1;
+			int w = 0;
+			for (std::size_t e = offsets[s]; e < offsets[s + 1]; ++e)
+				w += collision::edgeWinding(edges[e * 2], edges[e * 2 + 1], pt.x, pt.y);
+			return w;
+		}
+
+		bool contains(hVector pt) const { return winding(pt) != 0; }
+
+	}; // struct hPolygonSlabs
+
+
+	/// <summary>
+	/// A crossing between two segments, reported with the indices of both segments.
+	/// </summary>
+	struct hSegmentIntersection {
+		std::uint32_t a;
+		std::uint32_t b;
+		hVector point;
+	}; // struct hSegmentIntersection
+
+
+	/// <summary>
+	/// Finds all crossings within a large set of segments. Segments are bucketed into a uniform grid sized to the
+	/// segment count, and only segments sharing a cell are tested. Each crossing is reported once, from the cell
+	/// containing the crossing point. All working memory is kept between calls.
+	/// </summary>
+	class HSegmentIntersector {
+	private:
+		std::vector<hVector> m_start;
+		std::vector<hVector> m_end;
+		std::vector<std::uint32_t> m_next;
+		std::vector<std::uint32_t> m_cell_start;
+		std::vector<std::uint32_t> m_cell_cursor;
+		std::vector<std::uint32_t> m_cell_items;
+		hVector m_min;
+		hType_f m_scale = 1._hf;
+		std::size_t m_w = 1;
+		std::size_t m_h = 1;
+
+		std::size_t cellX(hType_f x) const {
+			return std::min(m_w - 1, static_cast<std::size_t>(std::max(0._hf, (x - m_min.x) * m_scale)));
+		}
+
+		std::size_t cellY(hType_f y) const {
+			return std::min(m_h - 1, static_cast<std::size_t>(std::max(0._hf, (y - m_min.y) * m_scale)));
+		}
+
+		/// Run a callback for every cell overlapped by the bounding box of segment <paramref name="i"/>.
+		template <typename TFunc>
+		void forCells(std::size_t i, TFunc f) const {
+			const std::size_t x1 = cellX(std::min(m_start[i].x, m_end[i].x)), x2 = cellX(std::max(m_start[i].x, m_end[i].x));
+			const std::size_t y1 = cellY(std::min(m_start[i].y, m_end[i].y)), y2 = cellY(std::max(m_start[i].y, m_end[i].y));
+			for (std::size_t y = y1; y <= y2; ++y)
+				for (std::size_t x = x1; x <= x2; ++x)
+					f(x + y * m_w);
+		}
+
+		/// <summary>
+		/// Find the crossing point of two segments. Overlapping collinear segments report the start of the overlap.
+		/// </summary>
+		static bool crossing(hVector p, hVector p2, hVector q, hVector q2, hVector& point) {
+			const hVector r = p2 - p;
+			const hVector s = q2 - q;
+			const hVector qp = q - p;
+			const hType_f denom = r.x * s.y - r.y * s.x;
+			const hType_f t_num = qp.x * s.y - qp.y * s.x;
+			const hType_f u_num = qp.x * r.y - qp.y * r.x;
+
+			if (denom == 0._hf) {
+				if (t_num != 0._hf)
+					return false;
+				// Collinear, project q onto r to find the overlapping range.
+				const hType_f rr = r.x * r.x + r.y * r.y;
+				if (rr == 0._hf)
+					return false;
+				hType_f t0 = (qp.x * r.x + qp.y * r.y) / rr;
+				hType_f t1 = t0 + (s.x * r.x + s.y * r.y) / rr;
+				if (t0 > t1)
+					std::swap(t0, t1);
+				if (t0 > 1._hf || t1 < 0._hf)
+					return false;
+				point = p + r * std::max(t0, 0._hf);
+				return true;
+			}
+
+			const hType_f t = t_num / denom;
+			const hType_f u = u_num / denom;
+			if (t < 0._hf || t > 1._hf || u < 0._hf || u > 1._hf)
+				return false;
+			point = p + r * t;
+			return true;
+		}
+
+		void run(std::vector<hSegmentIntersection>& out, bool skip_adjacent) {
+			const std::size_t n = m_start.size();
+			if (n < 2)
+				return;
+
+			hVector lo = m_start[0], hi = m_start[0];
+			for (std::size_t i = 0; i < n; ++i) {
+				for (hVector v : { m_start[i], m_end[i] }) {
+					lo = { std::min(lo.x, v.x), std::min(lo.y, v.y) };
+					hi = { std::max(hi.x, v.x), std::max(hi.y, v.y) };
+				}
+			}
+			hType_f extent = std::max(std::max(hi.x - lo.x, hi.y - lo.y), H_EPSILON);
+			std::size_t side = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(static_cast<double>(n))));
+			m_min = lo;
+			m_scale = static_cast<hType_f>(side) / extent;
+			m_w = side;
+			m_h = side;
+
+			m_cell_start.assign(m_w * m_h + 1, 0);
+			for (std::size_t i = 0; i < n; ++i)
+				forCells(i, [&](std::size_t c) { m_cell_start[c + 1]++; });
+			for (std::size_t c = 0; c < m_w * m_h; ++c)
+				m_cell_start[c + 1] += m_cell_start[c];
+			m_cell_items.resize(m_cell_start.back());
+			m_cell_cursor.assign(m_cell_start.begin(), m_cell_start.end() - 1);
+			for (std::size_t i = 0; i < n; ++i)
+				forCells(i, [&](std::size_t c) { m_cell_items[m_cell_cursor[c]++] = static_cast<std::uint32_t>(i); });
+
+			for (std::size_t y = 0; y < m_h; ++y)
+				for (std::size_t x = 0; x < m_w; ++x) {
+					const std::size_t cell = x + y * m_w;
+					for (std::uint32_t ia = m_cell_start[cell]; ia < m_cell_start[cell + 1]; ++ia)
+						for (std::uint32_t ib = ia + 1; ib < m_cell_start[cell + 1]; ++ib) {
+							std::uint32_t a = m_cell_items[ia];
+							std::uint32_t b = m_cell_items[ib];
+							if (skip_adjacent && (m_next[a] == b || m_next[b] == a))
+								continue;
+							hVector pt;
+							if (!crossing(m_start[a], m_end[a], m_start[b], m_end[b], pt))
+								continue;
+							// Clamp the crossing into the cells shared by both segments so rounding can not lose it.
+							std::size_t px = std::clamp(cellX(pt.x),
+								std::max(cellX(std::min(m_start[a].x, m_end[a].x)), cellX(std::min(m_start[b].x, m_end[b].x))),
+								std::min(cellX(std::max(m_start[a].x, m_end[a].x)), cellX(std::max(m_start[b].x, m_end[b].x))));
+							std::size_t py = std::clamp(cellY(pt.y),
+								std::max(cellY(std::min(m_start[a].y, m_end[a].y)), cellY(std::min(m_start[b].y, m_end[b].y))),
+								std::min(cellY(std::max(m_start[a].y, m_end[a].y)), cellY(std::max(m_start[b].y, m_end[b].y))));
+							if (px == x && py == y)
+								out.push_back({ std::min(a, b), std::max(a, b), pt });
+						}
+				}
+		}
+
+	public:
+
+		HSegmentIntersector() {}
+
+		/// <summary>
+		/// Find every crossing between a list of segments.
+		/// </summary>
+		/// <param name="starts">First point of each segment.</param>
+		/// <param name="ends">Second point of each segment.</param>
+		/// <param name="out">Crossings are appended here, with <c>a</c> less than <c>b</c>.</param>
+		void intersect(std::span<const hVector> starts, std::span<const hVector> ends, std::vector<hSegmentIntersection>& out) {
+			assert(ends.size() >= starts.size());
+			m_start.assign(starts.begin(), starts.end());
+			m_end.assign(ends.begin(), ends.begin() + starts.size());
+			m_next.assign(starts.size(), UINT32_MAX);
+			run(out, false);
+		}
+
+		/// <summary>
+		/// Find every crossing between the edges of a set of closed polygons. Edge <c>i</c> runs from vertex <c>i</c>
+		/// of the arena to the next vertex of the same polygon. Neighbouring edges of a polygon are not reported for
+		/// meeting at their shared vertex.
+		/// </summary>
+		void intersect(const hPolygonArena& polygons, std::vector<hSegmentIntersection>& out) {
+			m_start.assign(polygons.vertices.begin(), polygons.vertices.end());
+			m_end.resize(m_start.size());
+			m_next.resize(m_start.size());
+			for (std::size_t p = 0; p < polygons.size(); ++p) {
+				const std::size_t first = polygons.offsets[p];
+				const std::size_t last = polygons.offsets[p + 1];
+				for (std::size_t i = first; i < last; ++i) {
+					const std::size_t next = i + 1 < last ? i + 1 : first;
+					m_end[i] = polygons.vertices[next];
+					m_next[i] = static_cast<std::uint32_t>(next);
+				}
+			}
+			run(out, true);
+		}
+
+	}; // class HSegmentIntersector
+
+
+	namespace collision {
+
+		inline void contains(const hPolygonSlabs& slabs, std::span<const hVector> points, std::span<std::uint64_t> mask) {
+			assert(mask.size() >= maskWords(points.size()));
+			for (std::size_t first = 0; first < points.size(); first += 64) {
+				const std::size_t end = std::min<std::size_t>(64, points.size() - first);
+				std::uint64_t bits = 0;
+				for (std::size_t b = 0; b < end; ++b)
+					bits |= static_cast<std::uint64_t>(slabs.contains(points[first + b])) << b;
+				mask[first / 64] = bits;
+			}
+		}
+
+	} // namespace collision
+
+} // namespace hrzn
@@ -0,0 +1,697 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <limits>
+
+namespace hrzn {
+
+	/******************************************************************************************************************
+		Polygon clipping
+	******************************************************************************************************************/
+
+	namespace polygon {
+
+		/// <summary>
+		/// Clip a closed list of vertices against the half plane where <c>dot(normal, p) >= offset</c>.
+		/// </summary>
+		/// <param name="out">Cleared and filled with the clipped vertices.</param>
+		inline void clipHalfPlane(std::span<const hVector> in, hVector normal, hType_f offset, std::vector<hVector>& out) {
+			out.clear();
+			if (in.empty())
+				return;
+			hVector prev = in.back();
+			hType_f d_prev = normal.x * prev.x + normal.y * prev.y - offset;
+			for (const hVector& cur : in) {
+				hType_f d_cur = normal.x * cur.x + normal.y * cur.y - offset;
+				if ((d_cur >= 0._hf) != (d_prev >= 0._hf))
+					out.push_back(prev + (cur - prev) * (d_prev / (d_prev - d_cur)));
+				if (d_cur >= 0._hf)
+					out.push_back(cur);
+				prev = cur;
+				d_prev = d_cur;
+			}
+		}
+
+	} // namespace polygon
+
+
+	/// <summary>
+	/// Sutherland-Hodgman polygon clipper. Keeps its working buffers between calls, so clipping does not allocate
+	/// once the buffers have grown to fit the largest polygon.
+	/// </summary>
+	class HPolygonClipper {
+	private:
+		std::vector<hVector> m_front;
+		std::vector<hVector> m_back;
+
+		void clipPlane(hVector normal, hType_f offset) {
+			polygon::clipHalfPlane(m_front, normal, offset, m_back);
+			std::swap(m_front, m_back);
+		}
+
+		// Copy through the back buffer, as the subject may be the result of a previous clip still held in the front one
+		void load(hPolygonView subject) {
+			m_back.assign(subject.vertices.begin(), subject.vertices.end());
+			std::swap(m_front, m_back);
+		}
+
+		// Number of half planes a shape clips against, each of which can add at most one vertex
+		static std::size_t planeCount(const hBox&) { return 4; }
+		static std::size_t planeCount(const hArea&) { return 4; }
+		static std::size_t planeCount(hPolygonView convex) { return convex.count(); }
+
+	public:
+
+		HPolygonClipper() {}
+
+		/// <summary>
+		/// Clip a polygon to a rectangle.
+		/// </summary>
+		/// <returns>A view of the clipped polygon, valid until the next call to this clipper.</returns>
+		hPolygonView clip(hPolygonView subject, const hBox& box) {
+			load(subject);
+			clipPlane({ 1._hf, 0._hf }, std::min(box.v1.x, box.v2.x));
+			clipPlane({ -1._hf, 0._hf }, -std::max(box.v1.x, box.v2.x));
+			clipPlane({ 0._hf, 1._hf }, std::min(box.v1.y, box.v2.y));
+			clipPlane({ 0._hf, -1._hf }, -std::max(box.v1.y, box.v2.y));
+			return hPolygonView(m_front);
+		}
+
+		hPolygonView clip(hPolygonView subject, const hArea& area) {
+			return clip(subject, hBox(area));
+		}
+
+		/// <summary>
+		/// Clip a polygon to a convex polygon of any winding. The convex polygon must not be a view returned by this clipper.
+		/// </summary>
+		/// <returns>A view of the clipped polygon, valid until the next call to this clipper.</returns>
+		hPolygonView clip(hPolygonView subject, hPolygonView convex) {
+			load(subject);
+			const std::size_t n = convex.count();
+			const hType_f winding = polygon::signedArea(convex) < 0._hf ? -1._hf : 1._hf;
+			for (std::size_t i = 0, j = n - 1; i < n && !m_front.empty(); j = i++) {
+				hVector e = convex[i] - convex[j];
+				hVector normal = { -e.y * winding, e.x * winding };
+				clipPlane(normal, normal.x * convex[j].x + normal.y * convex[j].y);
+			}
+			return hPolygonView(m_front);
+		}
+
+		/// <summary>
+		/// Clip every polygon of an arena and append the results to another arena. Polygons which are clipped away
+		/// entirely are kept as empty entries so that indices match between the input and output.
+		/// </summary>
+		/// <remarks>
+		/// The output is reserved for the worst case, where every clipping plane adds one vertex to every polygon, so it does not
+		/// reallocate during the batch. <paramref name="out"/> may be <paramref name="subjects"/> itself, in which case the
+		/// clipped polygons are appended after the original ones.
+		/// </remarks>
+		template <typename TClip>
+		void clip(const hPolygonArena& subjects, const TClip& clip_shape, hPolygonArena& out) {
+			const std::size_t n = subjects.size();
+			out.vertices.reserve(out.vertices.size() + subjects.vertices.size() + n * planeCount(clip_shape));
+			out.offsets.reserve(out.offsets.size() + n);
+			for (std::size_t i = 0; i < n; ++i)
+				out.push_back(clip(subjects[i], clip_shape));
+		}
+
+		template <typename TClip>
+		void clip(std::span<const hPolygonView> subjects, const TClip& clip_shape, hPolygonArena& out) {
+			std::size_t count = 0;
+			for (const hPolygonView& poly : subjects)
+				count += poly.count();
+			out.vertices.reserve(out.vertices.size() + count + subjects.size() * planeCount(clip_shape));
+			out.offsets.reserve(out.offsets.size() + subjects.size());
+			for (const hPolygonView& poly : subjects)
+				out.push_back(clip(poly, clip_shape));
+		}
+
+	}; // class HPolygonClipper
+
+
+	/******************************************************************************************************************
+		Polygon triangulation
+	******************************************************************************************************************/
+
+	/// <summary>
+	/// Ear clipping triangulator for simple polygons with holes. Holes are first joined to the outer boundary with
+	/// bridge edges, then ears are clipped while a uniform grid of reflex vertices limits each ear test to the few
+	/// vertices near the candidate triangle. All working memory is kept between calls.
+	/// </summary>
+	class HTriangulator {
+	private:
+		std::vector<hVector> m_pts;
+		std::vector<std::uint32_t> m_vertex;
+		std::vector<std::uint32_t> m_next;
+		std::vector<std::uint32_t> m_prev;
+		std::vector<unsigned char> m_removed;
+
+		std::vector<std::uint32_t> m_cell_start;
+		std::vector<std::uint32_t> m_cell_items;
+		std::vector<std::uint32_t> m_cell_cursor;
+		hVector m_grid_min;
+		hType_f m_grid_scale = 1._hf;
+		std::size_t m_grid_w = 0;
+		std::size_t m_grid_h = 0;
+
+		std::vector<std::pair<hType_f, std::uint32_t>> m_holes;
+
+		static hType_f area2(hVector a, hVector b, hVector c) {
+			return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		}
+
+		static bool pointInTriangle(hVector a, hVector b, hVector c, hVector p) {
+			return area2(a, b, p) >= 0._hf && area2(b, c, p) >= 0._hf && area2(c, a, p) >= 0._hf;
+		}
+
+		std::uint32_t addNode(hVector pt, std::uint32_t vertex) {
+			std::uint32_t i = static_cast<std::uint32_t>(m_pts.size());
+			m_pts.push_back(pt);
+			m_vertex.push_back(vertex);
+			m_next.push_back(i);
+			m_prev.push_back(i);
+			m_removed.push_back(0);
+			return i;
+		}
+
+		void link(std::uint32_t a, std::uint32_t b) {
+			m_next[a] = b;
+			m_prev[b] = a;
+		}
+
+		/// Add a closed ring with the requested winding and return its first node.
+		std::uint32_t addRing(hPolygonView ring, std::uint32_t base, bool ccw) {
+			const std::size_t n = ring.count();
+			const bool reverse = (polygon::signedArea(ring) > 0._hf) != ccw;
+			std::uint32_t first = static_cast<std::uint32_t>(m_pts.size());
+			for (std::size_t k = 0; k < n; ++k) {
+				std::size_t i = reverse ? n - 1 - k : k;
+				addNode(ring[i], base + static_cast<std::uint32_t>(i));
+				if (k > 0)
+					link(first + static_cast<std::uint32_t>(k) - 1, first + static_cast<std::uint32_t>(k));
+			}
+			link(first + static_cast<std::uint32_t>(n) - 1, first);
+			return first;
+		}
+
+		/// Check if point <paramref name="p"/> lies inside the interior angle at node <paramref name="b"/>.
+		bool inSector(std::uint32_t b, hVector p) const {
+			hVector pb = m_pts[m_prev[b]];
+			hVector cb = m_pts[b];
+			hVector nb = m_pts[m_next[b]];
+			if (area2(pb, cb, nb) >= 0._hf)
+				return area2(pb, cb, p) >= 0._hf && area2(cb, nb, p) >= 0._hf;
+			return area2(pb, cb, p) >= 0._hf || area2(cb, nb, p) >= 0._hf;
+		}
+
+		/// <summary>
+		/// Find a vertex of the outer ring visible from hole vertex <paramref name="m"/> by casting a ray toward +x.
+		/// </summary>
+		std::uint32_t findBridge(std::uint32_t outer, std::uint32_t m) const {
+			const hVector mp = m_pts[m];
+			hType_f best_x = std::numeric_limits<hType_f>::max();
+			std::uint32_t cand = UINT32_MAX;
+			std::uint32_t a = outer;
+			do {
+				std::uint32_t b = m_next[a];
+				hVector pa = m_pts[a];
+				hVector pb = m_pts[b];
+				// Only edges heading upward face the inside of a counter-clockwise ring.
+				if (pa.y <= mp.y && pb.y >= mp.y && pa.y < pb.y) {
+					hType_f x = pa.x + (mp.y - pa.y) * (pb.x - pa.x) / (pb.y - pa.y);
+					if (x >= mp.x && x < best_x) {
+						best_x = x;
+						cand = pa.x > pb.x ? a : b;
+						if (x == pa.x && mp.y == pa.y)
+							cand = a;
+						else if (x == pb.x && mp.y == pb.y)
+							cand = b;
+					}
+				}
+				a = b;
+			} while (a != outer);
+
+			if (cand == UINT32_MAX)
+				return cand;
+
+			// Any reflex vertex inside the triangle between the hole, the hit point and the candidate blocks the view,
+			// in which case the one closest in angle to the ray is used.
+			const hVector hit = { best_x, mp.y };
+			const hVector cp = m_pts[cand];
+			if (cp != hit) {
+				hVector t1 = mp, t2 = hit, t3 = cp;
+				if (area2(t1, t2, t3) < 0._hf)
+					std::swap(t2, t3);
+				hType_f best_tan = std::numeric_limits<hType_f>::max();
+				a = outer;
+				do {
+					hVector p = m_pts[a];
+					if (a != cand && p.x >= mp.x && p != mp && pointInTriangle(t1, t2, t3, p)) {
+						hType_f tan = std::abs(mp.y - p.y) / std::max(p.x - mp.x, H_EPSILON);
+						if (tan < best_tan || (tan == best_tan && p.x < m_pts[cand].x)) {
+							best_tan = tan;
+							cand = a;
+						}
+					}
+					a = m_next[a];
+				} while (a != outer);
+			}
+
+			// Earlier bridges duplicate vertices, pick the copy whose interior angle faces the hole.
+			if (!inSector(cand, mp)) {
+				a = outer;
+				do {
+					if (m_pts[a] == m_pts[cand] && inSector(a, mp))
+						return a;
+					a = m_next[a];
+				} while (a != outer);
+			}
+			return cand;
+		}
+
+		/// Join the ring containing node <paramref name="m"/> into the ring containing <paramref name="b"/>.
+		void bridge(std::uint32_t b, std::uint32_t m) {
+			std::uint32_t b2 = addNode(m_pts[b], m_vertex[b]);
+			std::uint32_t m2 = addNode(m_pts[m], m_vertex[m]);
+			std::uint32_t bn = m_next[b];
+			std::uint32_t mp = m_prev[m];
+			link(b, m);
+			link(b2, bn);
+			link(m2, b2);
+			link(mp, m2);
+		}
+
+		void buildGrid(std::uint32_t start, std::size_t reflex_count) {
+			hVector lo = m_pts[start], hi = m_pts[start];
+			for (const hVector& p : m_pts) {
+				lo = { std::min(lo.x, p.x), std::min(lo.y, p.y) };
+				hi = { std::max(hi.x, p.x), std::max(hi.y, p.y) };
+			}
+			std::size_t side = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(static_cast<double>(reflex_count))));
+			hType_f extent = std::max(std::max(hi.x - lo.x, hi.y - lo.y), H_EPSILON);
+			m_grid_min = lo;
+			m_grid_scale = static_cast<hType_f>(side) / extent;
+			m_grid_w = side;
+			m_grid_h = side;
+
+			m_cell_start.assign(m_grid_w * m_grid_h + 1, 0);
+			m_cell_items.resize(reflex_count);
+			auto reflex = [&](std::uint32_t i) { return area2(m_pts[m_prev[i]], m_pts[i], m_pts[m_next[i]]) < 0._hf; };
+
+			std::uint32_t i = start;
+			do {
+				if (reflex(i))
+					m_cell_start[cellOf(m_pts[i]) + 1]++;
+				i = m_next[i];
+			} while (i != start);
+			for (std::size_t c = 0; c < m_grid_w * m_grid_h; ++c)
+				m_cell_start[c + 1] += m_cell_start[c];
+			m_cell_cursor.assign(m_cell_start.begin(), m_cell_start.end() - 1);
+			do {
+				if (reflex(i))
+					m_cell_items[m_cell_cursor[cellOf(m_pts[i])]++] = i;
+				i = m_next[i];
+			} while (i != start);
+		}
+
+		std::size_t cellX(hType_f x) const {
+			return std::min(m_grid_w - 1, static_cast<std::size_t>(std::max(0._hf, (x - m_grid_min.x) * m_grid_scale)));
+		}
+
+		std::size_t cellY(hType_f y) const {
+			return std::min(m_grid_h - 1, static_cast<std::size_t>(std::max(0._hf, (y - m_grid_min.y) * m_grid_scale)));
+		}
+
+		std::size_t cellOf(hVector p) const { return cellX(p.x) + cellY(p.y) * m_grid_w; }
+
+		bool isEar(std::uint32_t ear) const {
+			const std::uint32_t ia = m_prev[ear], ic = m_next[ear];
+			const hVector a = m_pts[ia], b = m_pts[ear], c = m_pts[ic];
+			if (area2(a, b, c) <= 0._hf)
+				return false;
+
+			const std::size_t x1 = cellX(std::min({ a.x, b.x, c.x })), x2 = cellX(std::max({ a.x, b.x, c.x }));
+			const std::size_t y1 = cellY(std::min({ a.y, b.y, c.y })), y2 = cellY(std::max({ a.y, b.y, c.y }));
+			for (std::size_t y = y1; y <= y2; ++y)
+				for (std::size_t x = x1; x <= x2; ++x) {
+					std::size_t cell = x + y * m_grid_w;
+					for (std::uint32_t k = m_cell_start[cell]; k < m_cell_start[cell + 1]; ++k) {
+						std::uint32_t r = m_cell_items[k];
+						if (m_removed[r] || r == ia || r == ear || r == ic)
+							continue;
+						hVector p = m_pts[r];
+						if (p == a || p == b || p == c)
+							continue;
+						if (area2(m_pts[m_prev[r]], p, m_pts[m_next[r]]) >= 0._hf)
+							continue;
+						if (pointInTriangle(a, b, c, p))
+							return false;
+					}
+				}
+			return true;
+		}
+
+	public:
+
+		HTriangulator() {}
+
+		/// Maximum number of indices written for a polygon with the given total vertex and hole counts.
+		static constexpr std::size_t indexCount(std::size_t vertices, std::size_t holes) {
+			return vertices + 2 * holes < 3 ? 0 : (vertices + 2 * holes - 2) * 3;
+		}
+
+		/// <summary>
+		/// Triangulate a polygon with holes.
+		/// </summary>
+		/// <param name="outer">Outer boundary of the polygon, in any winding.</param>
+		/// <param name="holes">Boundaries of the holes, in any winding. Vertices are numbered after the outer boundary, in order.</param>
+		/// <param name="indices">Receives three vertex indices per counter-clockwise triangle. Must hold <c>indexCount()</c> indices.</param>
+		/// <returns>The number of indices written.</returns>
+		std::size_t triangulate(hPolygonView outer, std::span<const hPolygonView> holes, std::span<std::uint32_t> indices) {
+			m_pts.clear();
+			m_vertex.clear();
+			m_next.clear();
+			m_prev.clear();
+			m_removed.clear();
+			m_holes.clear();
+			if (outer.count() < 3)
+				return 0;
+
+			std::size_t total = outer.count();
+			for (const hPolygonView& hole : holes)
+				total += hole.count();
+			assert(indices.size() >= indexCount(total, holes.size()));
+
+			std::uint32_t start = addRing(outer, 0, true);
+			std::uint32_t base = static_cast<std::uint32_t>(outer.count());
+			for (const hPolygonView& hole : holes) {
+				if (hole.count() >= 3) {
+					std::uint32_t first = addRing(hole, base, false);
+					std::uint32_t right = first;
+					for (std::uint32_t i = m_next[first]; i != first; i = m_next[i])
+						if (m_pts[i].x > m_pts[right].x)
+							right = i;
+					m_holes.emplace_back(m_pts[right].x, right);
+				}
+				base += static_cast<std::uint32_t>(hole.count());
+			}
+
+			std::sort(m_holes.begin(), m_holes.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+			for (const auto& hole : m_holes) {
+				std::uint32_t b = findBridge(start, hole.second);
+				if (b != UINT32_MAX)
+					bridge(b, hole.second);
+			}
+
+			std::size_t remaining = 0;
+			std::size_t reflex_count = 0;
+			std::uint32_t i = start;
+			do {
+				++remaining;
+				if (area2(m_pts[m_prev[i]], m_pts[i], m_pts[m_next[i]]) < 0._hf)
+					++reflex_count;
+				i = m_next[i];
+			} while (i != start);
+			buildGrid(start, reflex_count);
+
+			std::size_t written = 0;
+			auto emit = [&](std::uint32_t ear) {
+				indices[written++] = m_vertex[m_prev[ear]];
+				indices[written++] = m_vertex[ear];
+				indices[written++] = m_vertex[m_next[ear]];
+			};
+			auto remove = [&](std::uint32_t ear) {
+				link(m_prev[ear], m_next[ear]);
+				m_removed[ear] = 1;
+				--remaining;
+			};
+
+			std::uint32_t ear = start;
+			std::uint32_t stop = ear;
+			while (remaining > 3) {
+				std::uint32_t next = m_next[ear];
+				if (isEar(ear)) {
+					emit(ear);
+					remove(ear);
+					ear = m_next[next];
+					stop = ear;
+					continue;
+				}
+				ear = next;
+				if (ear != stop)
+					continue;
+
+				// A full pass found no ear. Drop a degenerate vertex if there is one, otherwise force a clip so that
+				// invalid input still terminates.
+				std::uint32_t degenerate = ear;
+				do {
+					if (area2(m_pts[m_prev[degenerate]], m_pts[degenerate], m_pts[m_next[degenerate]]) == 0._hf)
+						break;
+					degenerate = m_next[degenerate];
+				} while (degenerate != ear);
+
+				if (area2(m_pts[m_prev[degenerate]], m_pts[degenerate], m_pts[m_next[degenerate]]) != 0._hf)
+					emit(degenerate);
+				ear = m_next[degenerate];
+				remove(degenerate);
+				stop = ear;
+			}
+			if (remaining == 3 && area2(m_pts[m_prev[ear]], m_pts[ear], m_pts[m_next[ear]]) != 0._hf)
+				emit(ear);
+			return written;
+		}
+
+		std::size_t triangulate(hPolygonView outer, std::span<std::uint32_t> indices) {
+			return triangulate(outer, std::span<const hPolygonView>(), indices);
+		}
+
+	}; // class HTriangulator
+
+
+	/******************************************************************************************************************
+		Convex hull and simplification
+	******************************************************************************************************************/
+
+	/// <summary>
+	/// Computes convex hulls and simplified outlines. All algorithms are iterative, and the working buffers are
+	/// kept between calls. Results are written into caller owned vectors which are cleared first, so repeated calls
+	/// reuse their capacity.
+	/// </summary>
+	class HPolygonSimplifier {
+	private:
+		std::vector<hVector> m_sorted;
+		std::vector<unsigned char> m_keep;
+		std::vector<std::pair<std::size_t, std::size_t>> m_stack;
+		std::vector<std::size_t> m_next;
+		std::vector<std::size_t> m_prev;
+		std::vector<hType_f> m_area;
+		std::vector<std::pair<hType_f, std::size_t>> m_heap;
+
+		static hType_f cross(hVector o, hVector a, hVector b) {
+			return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+		}
+
+		static hType_f segmentDistanceSqr(hVector p, hVector a, hVector b) {
+			hVector ab = b - a;
+			hVector ap = p - a;
+			hType_f len = ab.lengthSqr();
+			hType_f t = len > 0._hf ? std::clamp((ap.x * ab.x + ap.y * ab.y) / len, 0._hf, 1._hf) : 0._hf;
+			hVector d = ap - ab * t;
+			return d.lengthSqr();
+		}
+
+		/// Simplify the chain between two kept vertices. Index <c>points.size()</c> wraps around to the first point.
+		void douglasPeuckerRange(std::span<const hVector> points, std::size_t first, std::size_t last, hType_f tol_sqr) {
+			const std::size_t n = points.size();
+			auto at = [&](std::size_t i) { return points[i < n ? i : i - n]; };
+			m_stack.clear();
+			m_stack.emplace_back(first, last);
+			while (!m_stack.empty()) {
+				auto [a, b] = m_stack.back();
+				m_stack.pop_back();
+				hType_f max_dist = tol_sqr;
+				std::size_t index = a;
+				for (std::size_t i = a + 1; i < b; ++i) {
+					hType_f d = segmentDistanceSqr(at(i), at(a), at(b));
+					if (d > max_dist) {
+						max_dist = d;
+						index = i;
+					}
+				}
+				if (index != a) {
+					m_keep[index] = 1;
+					m_stack.emplace_back(a, index);
+					m_stack.emplace_back(index, b);
+				}
+			}
+		}
+
+	public:
+
+		HPolygonSimplifier() {}
+
+		/// <summary>
+		/// Andrew's monotone chain convex hull.
+		/// </summary>
+		/// <param name="out">Receives the hull in counter-clockwise order, without collinear points.</param>
+		void convexHull(std::span<const hVector> points, std::vector<hVector>& out) {
+			out.clear();
+			m_sorted.assign(points.begin(), points.end());
+			std::sort(m_sorted.begin(), m_sorted.end(), [](const hVector& a, const hVector& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+			m_sorted.erase(std::unique(m_sorted.begin(), m_sorted.end()), m_sorted.end());
+			const std::size_t n = m_sorted.size();
+			if (n < 3) {
+				out.assign(m_sorted.begin(), m_sorted.end());
+				return;
+			}
+
+			out.resize(n * 2);
+			std::size_t k = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				while (k >= 2 && cross(out[k - 2], out[k - 1], m_sorted[i]) <= 0._hf)
+					--k;
+				out[k++] = m_sorted[i];
+			}
+			for (std::size_t i = n - 1, lower = k + 1; i-- > 0;) {
+				while (k >= lower && cross(out[k - 2], out[k - 1], m_sorted[i]) <= 0._hf)
+					--k;
+				out[k++] = m_sorted[i];
+			}
+			out.resize(k - 1);
+		}
+
+		/// <summary>
+		/// Douglas-Peucker simplification. Removes vertices closer than <paramref name="tolerance"/> to the simplified outline.
+		/// </summary>
+		/// <param name="closed">Treat the points as a closed polygon instead of an open polyline.</param>
+		void douglasPeucker(std::span<const hVector> points, hType_f tolerance, std::vector<hVector>& out, bool closed = false) {
+			out.clear();
+			const std::size_t n = points.size();
+			if (n < 3) {
+				out.assign(points.begin(), points.end());
+				return;
+			}
+
+			m_keep.assign(n, 0);
+			m_keep[0] = 1;
+			const hType_f tol_sqr = tolerance * tolerance;
+			if (closed) {
+				// Split the ring at the vertex farthest from the first one and simplify both halves.
+				std::size_t far = 1;
+				for (std::size_t i = 2; i < n; ++i)
+					if ((points[i] - points[0]).lengthSqr() > (points[far] - points[0]).lengthSqr())
+						far = i;
+				m_keep[far] = 1;
+				douglasPeuckerRange(points, 0, far, tol_sqr);
+				douglasPeuckerRange(points, far, n, tol_sqr);
+			}
+			else {
+				m_keep[n - 1] = 1;
+				douglasPeuckerRange(points, 0, n - 1, tol_sqr);
+			}
+
+			for (std::size_t i = 0; i < n; ++i)
+				if (m_keep[i])
+					out.push_back(points[i]);
+		}
+
+		/// <summary>
+		/// Visvalingam-Whyatt simplification. Repeatedly removes the vertex forming the smallest triangle with its
+		/// neighbours until every remaining triangle has an area of at least <paramref name="min_area"/>.
+		/// </summary>
+		/// <param name="closed">Treat the points as a closed polygon instead of an open polyline.</param>
+		void visvalingam(std::span<const hVector> points, hType_f min_area, std::vector<hVector>& out, bool closed = false) {
+			out.clear();
+			const std::size_t n = points.size();
+			const std::size_t min_count = closed ? 3 : 2;
+			if (n <= min_count) {
+				out.assign(points.begin(), points.end());
+				return;
+			}
+
+			constexpr std::size_t none = static_cast<std::size_t>(-1);
+			m_next.resize(n);
+			m_prev.resize(n);
+			m_area.assign(n, std::numeric_limits<hType_f>::max());
+			m_keep.assign(n, 1);
+			m_heap.clear();
+			for (std::size_t i = 0; i < n; ++i) {
+				m_next[i] = i + 1 < n ? i + 1 : (closed ? 0 : none);
+				m_prev[i] = i > 0 ? i - 1 : (closed ? n - 1 : none);
+			}
+
+			auto effective = [&](std::size_t i) {
+				return std::abs(cross(points[m_prev[i]], points[i], points[m_next[i]])) * 0.5_hf;
+			};
+			auto greater = [](const std::pair<hType_f, std::size_t>& a, const std::pair<hType_f, std::size_t>& b) { return a.first > b.first; };
+
+			for (std::size_t i = 0; i < n; ++i) {
+				if (m_prev[i] != none && m_next[i] != none) {
+					m_area[i] = effective(i);
+					m_heap.emplace_back(m_area[i], i);
+				}
+			}
+			std::make_heap(m_heap.begin(), m_heap.end(), greater);
+
+			std::size_t count = n;
+			while (!m_heap.empty() && count > min_count) {
+				std::pop_heap(m_heap.begin(), m_heap.end(), greater);
+				auto [area, i] = m_heap.back();
+				m_heap.pop_back();
+				// Skip entries left behind after a vertex's area was updated.
+				if (!m_keep[i] || area != m_area[i])
+					continue;
+				if (area >= min_area)
+					break;
+
+				m_keep[i] = 0;
+				--count;
+				std::size_t p = m_prev[i];
+				std::size_t q = m_next[i];
+				m_next[p] = q;
+				m_prev[q] = p;
+				for (std::size_t j : { p, q }) {
+					if (m_prev[j] != none && m_next[j] != none) {
+						// Never let a neighbour drop below the area just removed, so the order of removal stays stable.
+						m_area[j] = std::max(effective(j), area);
+						m_heap.emplace_back(m_area[j], j);
+						std::push_heap(m_heap.begin(), m_heap.end(), greater);
+					}
+				}
+			}
+
+			for (std::size_t i = 0; i < n; ++i)
+				if (m_keep[i])
+					out.push_back(points[i]);
+		}
+
+	}; // class HPolygonSimplifier
+
+} // namespace hrzn
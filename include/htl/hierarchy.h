@@ -0,0 +1,222 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <numeric>
+
+namespace hrzn {
+
+	/// <summary>
+	/// A flat transform hierarchy. Nodes are stored in contiguous arrays with every parent placed before its children,
+	/// so all world matrices can be refreshed in one forward pass that only touches nodes under a changed transform.
+	/// </summary>
+	class HTransformHierarchy {
+	public:
+
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	private:
+
+		std::vector<std::size_t> m_parent;
+		std::vector<std::size_t> m_end;
+		std::vector<hTransform> m_local;
+		std::vector<hAffine> m_world;
+		std::vector<unsigned char> m_dirty;
+		bool m_depth_first = true;
+
+	public:
+
+		HTransformHierarchy() {}
+
+		std::size_t size() const { return m_parent.size(); }
+
+		void reserve(std::size_t n) {
+			m_parent.reserve(n);
+			m_end.reserve(n);
+			m_local.reserve(n);
+			m_world.reserve(n);
+			m_dirty.reserve(n);
+		}
+
+		void clear() {
+			m_parent.clear();
+			m_end.clear();
+			m_local.clear();
+			m_world.clear();
+			m_dirty.clear();
+			m_depth_first = true;
+		}
+
+		/// <summary>
+		/// Add a node to the hierarchy.
+		/// </summary>
+		/// <param name="local">Transform of the node relative to its parent.</param>
+		/// <param name="parent">Index of an existing parent node, or <c>npos</c> for a root node.</param>
+		/// <returns>Index of the new node.</returns>
+		std::size_t add(const hTransform& local, std::size_t parent = npos) {
+			if (parent != npos && parent >= size())
+				throw std::out_of_range("Parent index is not located in the hierarchy.");
+			std::size_t i = size();
+			// Appending keeps the subtree ranges contiguous only when the new node belongs to the last branch.
+			if (parent != npos && m_end[parent] != i)
+				m_depth_first = false;
+			m_parent.push_back(parent);
+			m_end.push_back(i + 1);
+			m_local.push_back(local);
+			m_world.emplace_back();
+			m_dirty.push_back(1);
+			for (std::size_t p = parent; p != npos; p = m_parent[p])
+				m_end[p] = i + 1;
+			return i;
+		}
+
+		std::size_t parent(std::size_t i) const { return m_parent[i]; }
+
+		const hTransform& local(std::size_t i) const { return m_local[i]; }
+
+		void setLocal(std::size_t i, const hTransform& tform) {
+			m_local[i] = tform;
+			m_dirty[i] = 1;
+		}
+
+		/// Flag a node as changed after modifying its local transform in place.
+		void markDirty(std::size_t i) { m_dirty[i] = 1; }
+
+		bool dirty(std::size_t i) const { return m_dirty[i] != 0; }
+
+		/// <summary>
+		/// Get the local-to-world matrix of a node. Only valid after <c>update()</c> has been called since the last change.
+		/// </summary>
+		const hAffine& world(std::size_t i) const { return m_world[i]; }
+
+		/// <summary>
+		/// Check whether every subtree occupies a contiguous index range. See <c>sortDepthFirst()</c>.
+		/// </summary>
+		bool depthFirst() const { return m_depth_first; }
+
+		/// <summary>
+		/// Get the index one past the last descendant of a node. Requires the hierarchy to be in depth first order.
+		/// </summary>
+		std::size_t subtreeEnd(std::size_t i) const {
+			assert(m_depth_first);
+			return m_end[i];
+		}
+
+		/// <summary>
+		/// Collect the index ranges of every root subtree. Each range can be updated independently on its own thread.
+		/// </summary>
+		std::vector<std::pair<std::size_t, std::size_t>> subtrees() const {
+			assert(m_depth_first);
+			std::vector<std::pair<std::size_t, std::size_t>> list;
+			for (std::size_t i = 0; i < size(); i = m_end[i])
+				list.emplace_back(i, m_end[i]);
+			return list;
+		}
+
+		/// <summary>
+		/// Recompute world matrices for a range of nodes without clearing the dirty flags.
+		/// All parents outside of the range must already be up to date. Disjoint subtrees may be updated concurrently,
+		/// followed by a single call to <c>clearDirty()</c>.
+		/// </summary>
+		void update(std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; ++i) {
+				std::size_t p = m_parent[i];
+				if (p != npos)
+					m_dirty[i] |= m_dirty[p];
+				if (m_dirty[i])
+					m_world[i] = p == npos ? hAffine(m_local[i]) : m_world[p] * hAffine(m_local[i]);
+			}
+		}
+
+		void clearDirty() {
+			std::fill(m_dirty.begin(), m_dirty.end(), 0);
+		}
+
+		/// <summary>
+		/// Recompute all world matrices affected by changes since the last update.
+		/// </summary>
+		void update() {
+			update(0, size());
+			clearDirty();
+		}
+
+		/// <summary>
+		/// Reorder the nodes so that every subtree occupies a contiguous range of indices.
+		/// </summary>
+		/// <returns>A table mapping each old index to its new index.</returns>
+		std::vector<std::size_t> sortDepthFirst() {
+			const std::size_t n = size();
+			std::vector<std::size_t> first_child(n, npos);
+			std::vector<std::size_t> next_sibling(n, npos);
+			// Link children in reverse so that siblings keep their original relative order.
+			for (std::size_t i = n; i-- > 0;) {
+				std::size_t p = m_parent[i];
+				if (p != npos) {
+					next_sibling[i] = first_child[p];
+					first_child[p] = i;
+				}
+			}
+
+			std::vector<std::size_t> order;
+			order.reserve(n);
+			std::vector<std::size_t> stack;
+			for (std::size_t r = 0; r < n; ++r) {
+				if (m_parent[r] != npos)
+					continue;
+				stack.push_back(r);
+				while (!stack.empty()) {
+					std::size_t i = stack.back();
+					stack.pop_back();
+					order.push_back(i);
+					// Push children in reverse so the first child is visited first.
+					std::size_t mark = stack.size();
+					for (std::size_t c = first_child[i]; c != npos; c = next_sibling[c])
+						stack.push_back(c);
+					std::reverse(stack.begin() + mark, stack.end());
+				}
+			}
+
+			std::vector<std::size_t> remap(n);
+			for (std::size_t i = 0; i < n; ++i)
+				remap[order[i]] = i;
+
+			HTransformHierarchy sorted;
+			sorted.reserve(n);
+			for (std::size_t i = 0; i < n; ++i) {
+				std::size_t old = order[i];
+				std::size_t p = m_parent[old];
+				sorted.add(m_local[old], p == npos ? npos : remap[p]);
+				sorted.m_world[i] = m_world[old];
+				sorted.m_dirty[i] = m_dirty[old];
+			}
+			*this = std::move(sorted);
+			return remap;
+		}
+
+	}; // class HTransformHierarchy
+
+} // namespace hrzn
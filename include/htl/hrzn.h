@@ -30,6 +30,14 @@ SOFTWARE.
 #include <stdexcept>
 #include <iterator>
 #include <vector>
+#include <span>
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <functional>
+#include <tuple>
 
 #define H_PI 3.1415926535897932384626433832795_hf
 #define H_DEGTORAD 0.017453_hf
@@ -93,12 +101,12 @@ namespace hrzn {
 
 	template<typename T>
 	struct vEpsilon<T, false> {
-		inline static T value = 1_hi;
+		static constexpr T value = 1_hi;
 	};
 
 	template<typename T>
 	struct vEpsilon<T, true> {
-		inline static T value = H_EPSILON;
+		static constexpr T value = H_EPSILON;
 	};
 
 
@@ -127,39 +135,39 @@ namespace hrzn {
 		template <typename TCast>
 		explicit constexpr ITuple(const ITuple<TCast>& t) : x(static_cast<T>(t.x)), y(static_cast<T>(t.y)) {}
 
-		T operator [] (int i) const { return (&x)[i]; }
+		constexpr T operator [] (int i) const { return i == 0 ? x : y; }
 
-		T& operator [] (int i) { return (&x)[i]; }
+		constexpr T& operator [] (int i) { return i == 0 ? x : y; }
 
-		operator bool() const { return x != 0 || y != 0; }
+		constexpr operator bool() const { return x != 0 || y != 0; }
 
 		template <typename TCast>
-		void operator =(const ITuple<TCast>& t) {
+		constexpr void operator =(const ITuple<TCast>& t) {
 			x = static_cast<T>(t.x);
 			y = static_cast<T>(t.y);
 		}
 
-		ITuple<T> signumAxis() const { // TODO test signum axis
+		constexpr ITuple<T> signumAxis() const { // TODO test signum axis
 			return { (T(0) < this->x) - (this->x < T(0)), (T(0) < this->y) - (this->y < T(0)) };
 		}
 
-		void set(T xval, T yval) { this->x = xval; this->y = yval; }
+		constexpr void set(T xval, T yval) { this->x = xval; this->y = yval; }
 
-		void set(ITuple<T> other) { this->x = other.x; this->y = other.y; }
+		constexpr void set(ITuple<T> other) { this->x = other.x; this->y = other.y; }
 
-		void shift(T xshift, T yshift) { this->x += xshift; this->y += yshift; }
+		constexpr void shift(T xshift, T yshift) { this->x += xshift; this->y += yshift; }
 
-		void shift(ITuple<T> const& amt) { this->shift(amt.x, amt.y); }
+		constexpr void shift(ITuple<T> const& amt) { this->shift(amt.x, amt.y); }
 
-		void scale(T mag) { this->x *= mag; this->y *= mag; }
+		constexpr void scale(T mag) { this->x *= mag; this->y *= mag; }
 
 		double length() const { return std::sqrt(this->x * this->x + this->y * this->y); }
 
-		ITuple<T> swizzle() const { return { this->y, this->x }; }
+		constexpr ITuple<T> swizzle() const { return { this->y, this->x }; }
 
-		T lengthSqr() const { return this->x * this->x + this->y * this->y; }
+		constexpr T lengthSqr() const { return this->x * this->x + this->y * this->y; }
 
-		T lengthManhattan() const { return std::abs(this->x) + std::abs(this->y); }
+		constexpr T lengthManhattan() const { return (this->x < T(0) ? -this->x : this->x) + (this->y < T(0) ? -this->y : this->y); }
 
 		/// <summary>
 		/// Find the unit vector of the tuple.
@@ -191,7 +199,7 @@ namespace hrzn {
 		/// Create a new tuple contining the smallest values of x and y where the they are non-zero.
 		/// </summary>
 		/// <returns></returns>
-		ITuple<T> epsilon() const {
+		constexpr ITuple<T> epsilon() const {
 			return { vEpsilon<T>::value, vEpsilon<T>::value };
 		}
 
@@ -205,60 +213,60 @@ namespace hrzn {
 	// Operator overloads for ITuple objects
 
 	template <typename T>
-	ITuple<T> operator - (const ITuple<T>& a) { return ITuple<T>(-a.x, -a.y); }
+	constexpr ITuple<T> operator - (const ITuple<T>& a) { return ITuple<T>(-a.x, -a.y); }
 
 	template <typename T, typename TCast>
-	bool operator ==(const ITuple<T>& a, const ITuple<TCast>& b) { return a.x == static_cast<T>(b.x) && a.y == static_cast<T>(b.y); }
+	constexpr bool operator ==(const ITuple<T>& a, const ITuple<TCast>& b) { return a.x == static_cast<T>(b.x) && a.y == static_cast<T>(b.y); }
 
 	template <typename T, typename TCast>
-	bool operator !=(const ITuple<T>& a, const ITuple<TCast>& b) { return !(a == b); }
+	constexpr bool operator !=(const ITuple<T>& a, const ITuple<TCast>& b) { return !(a == b); }
 
 	template <typename T, typename TCast>
-	ITuple<T>& operator += (ITuple<T>& a, const ITuple<TCast>& b) {
+	constexpr ITuple<T>& operator += (ITuple<T>& a, const ITuple<TCast>& b) {
 		a.x += static_cast<T>(b.x); a.y += static_cast<T>(b.y);
 		return a;
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T>& operator -= (ITuple<T>& a, const ITuple<TCast>& b) {
+	constexpr ITuple<T>& operator -= (ITuple<T>& a, const ITuple<TCast>& b) {
 		a.x -= static_cast<T>(b.x); a.y -= static_cast<T>(b.y);
 		return a;
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T> operator + (const ITuple<T>& a, const ITuple<TCast>& b) {
+	constexpr ITuple<T> operator + (const ITuple<T>& a, const ITuple<TCast>& b) {
 		return ITuple<T>(a.x + static_cast<T>(b.x), a.y + static_cast<T>(b.y));
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T> operator - (const ITuple<T>& a, const ITuple<TCast>& b) {
+	constexpr ITuple<T> operator - (const ITuple<T>& a, const ITuple<TCast>& b) {
 		return ITuple<T>(a.x - static_cast<T>(b.x), a.y - static_cast<T>(b.y));
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T> operator * (const ITuple<T>& a, const ITuple<TCast>& b) {
+	constexpr ITuple<T> operator * (const ITuple<T>& a, const ITuple<TCast>& b) {
 		return ITuple<T>(a.x * static_cast<T>(b.x), a.y * static_cast<T>(b.y));
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T> operator / (const ITuple<T>& a, const ITuple<TCast>& b) {
+	constexpr ITuple<T> operator / (const ITuple<T>& a, const ITuple<TCast>& b) {
 		return ITuple<T>(a.x / static_cast<T>(b.x), a.y / static_cast<T>(b.y));
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T> operator * (const ITuple<T>& a, TCast val) {
+	constexpr ITuple<T> operator * (const ITuple<T>& a, TCast val) {
 		static_assert(std::is_arithmetic_v<TCast>, "An arithmetic type is required for Tuple operations");
 		return ITuple<T>(a.x * static_cast<T>(val), a.y * static_cast<T>(val));
 	}
 
 	template <typename T, typename TCast>
-	ITuple<T> operator / (const ITuple<T>& a, TCast val) {
+	constexpr ITuple<T> operator / (const ITuple<T>& a, TCast val) {
 		static_assert(std::is_arithmetic_v<TCast>, "An arithmetic type is required for Tuple operations");
 		return ITuple<T>(a.x / static_cast<T>(val), a.y / static_cast<T>(val));
 	}
 
 	template <typename T>
-	ITuple<T> operator ~ (const ITuple<T>& a) { return ITuple<T>(a.y, a.x); }
+	constexpr ITuple<T> operator ~ (const ITuple<T>& a) { return ITuple<T>(a.y, a.x); }
 
 	_GENERATE_MATHF(sqrt);
 	_GENERATE_MATHF(abs);
@@ -280,6 +288,81 @@ namespace hrzn {
 	using hVector = ITuple<hType_f>;
 	/// Type alias for Tuples of INT types.
 	using hPoint = ITuple<hType_i>;
+	/// Type alias for compact Tuples of 16 bit signed cell coordinates.
+	using hPoint16 = ITuple<std::int16_t>;
+	/// Type alias for compact Tuples of 16 bit unsigned cell coordinates.
+	using hPointU16 = ITuple<std::uint16_t>;
+
+	/// <summary>
+	/// Check whether both components of a tuple can be converted to <typeparamref name="TTo"/> without leaving its range.
+	/// </summary>
+	template <typename TTo, typename TFrom>
+	constexpr bool fits(const ITuple<TFrom>& t) {
+		if constexpr (std::is_integral_v<TTo> && std::is_integral_v<TFrom>) {
+			return std::in_range<TTo>(t.x) && std::in_range<TTo>(t.y);
+		}
+		else if constexpr (std::is_integral_v<TTo>) {
+			constexpr TFrom lo = static_cast<TFrom>(std::numeric_limits<TTo>::lowest());
+			constexpr TFrom hi = static_cast<TFrom>(std::numeric_limits<TTo>::max()) + TFrom(1);
+			return t.x >= lo && t.x < hi && t.y >= lo && t.y < hi;
+		}
+		else {
+			return true;
+		}
+	}
+
+	/// <summary>
+	/// Convert a tuple to <typeparamref name="TTo"/>, throwing <c>std::out_of_range</c> if either component does not fit.
+	/// </summary>
+	template <typename TTo, typename TFrom>
+	constexpr ITuple<TTo> narrow(const ITuple<TFrom>& t) {
+		if (!fits<TTo>(t))
+			throw std::out_of_range("Tuple component is out of range for the target type.");
+		return ITuple<TTo>(t);
+	}
+
+	/// <summary>
+	/// Convert a tuple to <typeparamref name="TTo"/>, clamping each component to the range of the target type. NaN becomes zero.
+	/// </summary>
+	template <typename TTo, typename TFrom>
+	constexpr ITuple<TTo> saturate(const ITuple<TFrom>& t) {
+		auto clamp = [](TFrom v) -> TTo {
+			constexpr TTo lo = std::numeric_limits<TTo>::lowest();
+			constexpr TTo hi = std::numeric_limits<TTo>::max();
+			if constexpr (std::is_integral_v<TTo> && std::is_integral_v<TFrom>) {
+				return std::cmp_less(v, lo) ? lo : std::cmp_greater(v, hi) ? hi : static_cast<TTo>(v);
+			}
+			else if constexpr (std::is_integral_v<TTo>) {
+				if (v != v)
+					return TTo(0);
+				return v < static_cast<TFrom>(lo) ? lo : v >= static_cast<TFrom>(hi) ? hi : static_cast<TTo>(v);
+			}
+			else {
+				return static_cast<TTo>(v);
+			}
+		};
+		return ITuple<TTo>(clamp(t.x), clamp(t.y));
+	}
+
+	/// <summary>
+	/// Pack a 16 bit point into a 32 bit key with y in the high half. Signed components are biased so that comparing keys as
+	/// unsigned integers orders points row by row (by y, then x), the same order in which maps store their cells.
+	/// </summary>
+	constexpr std::uint32_t packKey(hPoint16 p) {
+		return (std::uint32_t(std::uint16_t(p.y) ^ 0x8000u) << 16) | std::uint32_t(std::uint16_t(p.x) ^ 0x8000u);
+	}
+
+	constexpr std::uint32_t packKey(hPointU16 p) {
+		return (std::uint32_t(p.y) << 16) | std::uint32_t(p.x);
+	}
+
+	/// Recover the point stored in a key from <see cref="packKey"/>.
+	template <typename T>
+	constexpr ITuple<T> unpackKey(std::uint32_t key) {
+		static_assert(std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::uint16_t>, "Keys hold 16 bit coordinates.");
+		const std::uint16_t bias = std::is_signed_v<T> ? 0x8000u : 0u;
+		return ITuple<T>(static_cast<T>(std::uint16_t(key & 0xffffu) ^ bias), static_cast<T>(std::uint16_t(key >> 16) ^ bias));
+	}
 
 	/// <summary>
 	/// An array of unit vectors containinf the vertices of a quadrilateral.
@@ -328,114 +411,125 @@ namespace hrzn {
 	};
 
 	/// <summary>
-	/// A class for managing rotations and angles.
+	/// A class for managing rotations and angles, stored in turns.
 	/// </summary>
-	struct hRotation {
+	/// <typeparam name="T">Floating point type of the angle.</typeparam>
+	template <typename T>
+	struct IRotation {
 
-		hType_f tau;
+		static constexpr T turn_deg = static_cast<T>(360.0L);
+		static constexpr T turn_rad = static_cast<T>(6.283185307179586476925286766559L);
 
-		constexpr hRotation() : tau(0.f) {}
+		T tau;
 
-		constexpr hRotation(hType_f a) : tau(a) {}
+		constexpr IRotation() : tau(0) {}
 
-		hRotation operator-() const { return hRotation(-tau); }
+		constexpr IRotation(T a) : tau(a) {}
 
-		hRotation operator + (hRotation const& other) const { return hRotation(tau + other.tau); }
-		hRotation operator - (hRotation const& other) const { return hRotation(tau - other.tau); }
-		hRotation operator * (hRotation const& other) const { return hRotation(tau * other.tau); }
-		hRotation operator / (hRotation const& other) const { return hRotation(tau / other.tau); }
+		template <typename TCast>
+		explicit constexpr IRotation(const IRotation<TCast>& r) : tau(static_cast<T>(r.tau)) {}
 
-		template <typename T>
-		hRotation operator + (T const& val) const { return hRotation(tau + static_cast<hType_f>(val)); }
+		constexpr IRotation operator-() const { return IRotation(-tau); }
 
-		template <typename T>
-		hRotation operator - (T const& val) const { return hRotation(tau - static_cast<hType_f>(val)); }
+		constexpr IRotation operator + (IRotation const& other) const { return IRotation(tau + other.tau); }
+		constexpr IRotation operator - (IRotation const& other) const { return IRotation(tau - other.tau); }
+		constexpr IRotation operator * (IRotation const& other) const { return IRotation(tau * other.tau); }
+		constexpr IRotation operator / (IRotation const& other) const { return IRotation(tau / other.tau); }
 
-		template <typename T>
-		hRotation operator * (T const& val) const { return hRotation(tau * static_cast<hType_f>(val)); }
+		template <typename TCast>
+		constexpr IRotation operator + (TCast const& val) const { return IRotation(tau + static_cast<T>(val)); }
 
-		template <typename T>
-		hRotation operator / (T const& val) const { return hRotation(tau / static_cast<hType_f>(val)); }
+		template <typename TCast>
+		constexpr IRotation operator - (TCast const& val) const { return IRotation(tau - static_cast<T>(val)); }
+
+		template <typename TCast>
+		constexpr IRotation operator * (TCast const& val) const { return IRotation(tau * static_cast<T>(val)); }
+
+		template <typename TCast>
+		constexpr IRotation operator / (TCast const& val) const { return IRotation(tau / static_cast<T>(val)); }
 
-		auto addDeg(hType_f deg) {
-			tau += (deg / H_DEG);
-			return tau * H_DEG;
+		auto addDeg(T deg) {
+			tau += (deg / turn_deg);
+			return tau * turn_deg;
 		}
 
-		auto addRad(hType_f rad) {
-			tau += (rad / H_RAD);
-			return tau * H_RAD;
+		auto addRad(T rad) {
+			tau += (rad / turn_rad);
+			return tau * turn_rad;
 		}
 
-		void setDeg(hType_f deg) {
-			tau = deg / H_DEG;
+		void setDeg(T deg) {
+			tau = deg / turn_deg;
 		}
 
-		void setRad(hType_f rad) {
-			tau = rad / H_RAD;
+		void setRad(T rad) {
+			tau = rad / turn_rad;
 		}
 
-		inline auto deg() const { return tau * H_DEG; }
+		constexpr auto deg() const { return tau * turn_deg; }
 
-		inline auto rad() const { return tau * H_RAD; }
+		constexpr auto rad() const { return tau * turn_rad; }
 
-		inline void spin(hType_f t) {
+		inline void spin(T t) {
 			tau += t;
 		}
 
-		hRotation angle() const {
-			return std::fmod(tau - std::trunc(tau) + 1._hf, 1._hf);
+		IRotation angle() const {
+			return std::fmod(tau - std::trunc(tau) + T(1), T(1));
 		}
 
-		hRotation revolutions() const {
+		IRotation revolutions() const {
 			return std::trunc(tau);
 		}
 
-		hRotation flip() const {
-			return hRotation(tau + 0.5_hf).angle();
+		IRotation flip() const {
+			return IRotation(tau + T(0.5)).angle();
 		}
 
-		hRotation inverse() const {
-			return hRotation(1.0_hf - angle().tau);
+		IRotation inverse() const {
+			return IRotation(T(1) - angle().tau);
 		}
 
-		void setWithVector(hVector vec) {
-			tau = std::atan2(vec.y, vec.x) / H_RAD;
+		void setWithVector(ITuple<T> vec) {
+			tau = std::atan2(vec.y, vec.x) / turn_rad;
 			tau = tau - std::floor(tau);
 		}
 
-		hVector getForwardVector(hType_f length = 1._hf) const {
-			return hVector(std::cos(rad()) * length, std::sin(rad()) * length);
+		ITuple<T> getForwardVector(T length = T(1)) const {
+			return ITuple<T>(std::cos(rad()) * length, std::sin(rad()) * length);
 		}
 
-		hVector getRightVector(hType_f length = 1._hf) const {
-			return hVector(std::cos(rad() + H_PI * 0.5_hf) * length, std::sin(rad() + H_PI * 0.5_hf) * length);
+		ITuple<T> getRightVector(T length = T(1)) const {
+			return ITuple<T>(std::cos(rad() + turn_rad * T(0.25)) * length, std::sin(rad() + turn_rad * T(0.25)) * length);
 		}
 
-		hVector rotate(hVector const& vec) const {
-			hType_f a = angle().rad();
-			hType_f x = std::cos(a) * vec.x - std::sin(a) * vec.y;
-			hType_f y = std::sin(a) * vec.x + std::cos(a) * vec.y;
-			return hVector(x, y);
+		ITuple<T> rotate(ITuple<T> const& vec) const {
+			T a = angle().rad();
+			T x = std::cos(a) * vec.x - std::sin(a) * vec.y;
+			T y = std::sin(a) * vec.x + std::cos(a) * vec.y;
+			return ITuple<T>(x, y);
 		}
 
-		hVector unrotate(hVector const& vec) const {
-			hType_f a = angle().rad();
-			hType_f x = std::cos(-a) * vec.x - std::sin(-a) * vec.y;
-			hType_f y = std::sin(-a) * vec.x + std::cos(-a) * vec.y;
-			return hVector(x, y);
+		ITuple<T> unrotate(ITuple<T> const& vec) const {
+			T a = angle().rad();
+			T x = std::cos(-a) * vec.x - std::sin(-a) * vec.y;
+			T y = std::sin(-a) * vec.x + std::cos(-a) * vec.y;
+			return ITuple<T>(x, y);
 		}
 
-		static hRotation difference(hRotation a, hRotation b) {
-			hType_f diff = a.angle().tau - b.angle().tau + 0.5_hf;
-			return hRotation(diff - std::floor(diff) - 0.5_hf);
+		static IRotation difference(IRotation a, IRotation b) {
+			T diff = a.angle().tau - b.angle().tau + T(0.5);
+			return IRotation(diff - std::floor(diff) - T(0.5));
 		}
 
-		static hRotation Degrees(hType_f deg) { return hRotation(deg / H_DEG); }
+		static constexpr IRotation Degrees(T deg) { return IRotation(deg / turn_deg); }
+
+		static constexpr IRotation Radians(T rad) { return IRotation(rad / turn_rad); }
 
-		static hRotation Radians(hType_f rad) { return hRotation(rad / H_RAD); }
+	}; // struct IRotation<T>
 
-	}; // struct hRotation
+	/// Type alias for rotations of FLOAT type.
+	using hRotation = IRotation<hType_f>;
 
 
 	/******************************************************************************************************************
@@ -445,110 +539,119 @@ namespace hrzn {
 	/// <summary>
 	/// A class for managing coordinates of a 2D area.
 	/// </summary>
-	struct hArea {
+	/// <typeparam name="T">Integral type of the coordinates.</typeparam>
+	template <typename T>
+	struct IArea {
 
-		hType_i x1, y1, x2, y2;
+		T x1, y1, x2, y2;
 
-		constexpr hArea() : x1(INT_MAX), y1(INT_MAX), x2(INT_MIN), y2(INT_MIN) {}
+		constexpr IArea() : x1(std::numeric_limits<T>::max()), y1(std::numeric_limits<T>::max()), x2(std::numeric_limits<T>::lowest()), y2(std::numeric_limits<T>::lowest()) {}
 
-		constexpr hArea(hType_u w, hType_u h) : x1(0), y1(0), x2((hType_i)w), y2((hType_i)h) {}
+		constexpr IArea(hType_u w, hType_u h) : x1(0), y1(0), x2((T)w), y2((T)h) {}
 
-		constexpr hArea(hType_i x_1, hType_i y_1, hType_i x_2, hType_i y_2) : x1(x_1), y1(y_1), x2(x_2), y2(y_2) {}
+		constexpr IArea(T x_1, T y_1, T x_2, T y_2) : x1(x_1), y1(y_1), x2(x_2), y2(y_2) {}
 
-		explicit constexpr hArea(hPoint p1, hPoint p2) : x1(p1.x), y1(p1.y), x2(p2.x), y2(p2.y) {}
+		explicit constexpr IArea(ITuple<T> p1, ITuple<T> p2) : x1(p1.x), y1(p1.y), x2(p2.x), y2(p2.y) {}
 
-		hArea& operator +=(hPoint dist) {
+		template <typename TCast>
+		explicit constexpr IArea(const IArea<TCast>& other) : x1(static_cast<T>(other.x1)), y1(static_cast<T>(other.y1)), x2(static_cast<T>(other.x2)), y2(static_cast<T>(other.y2)) {}
+
+		constexpr IArea& operator +=(ITuple<T> dist) {
 			move(dist.x, dist.y);
 			return *this;
 		}
 
-		hArea& operator -=(hPoint dist) {
+		constexpr IArea& operator -=(ITuple<T> dist) {
 			move(-dist.x, -dist.y);
 			return *this;
 		}
 
-		operator bool() const {
+		constexpr operator bool() const {
 			return x1 < x2 && y1 < y2;
 		}
 
-		bool valid() const {
+		constexpr bool valid() const {
 			return x1 < x2 && y1 < y2;
 		}
 
-		void move(hType_i move_x, hType_i move_y) {
+		constexpr void move(T move_x, T move_y) {
 			x1 += move_x;
 			y1 += move_y;
 			x2 += move_x;
 			y2 += move_y;
 		}
 
-		virtual void resize(hType_i x_1, hType_i y_1, hType_i x_2, hType_i y_2) {
+		constexpr virtual void resize(T x_1, T y_1, T x_2, T y_2) {
 			x1 = std::min(x_1, x_2);
 			x2 = std::max(x_1, x_2);
 			y1 = std::min(y_1, y_2);
 			y2 = std::max(y_1, y_2);
 		}
 
-		void resize(const hPoint& size) {
+		constexpr void resize(const ITuple<T>& size) {
 			if (size) {
 				resize(std::min(x1, x1 + size.x), std::min(y1, y1 + size.y), std::max(x1, x1 + size.x), std::max(y1, y1 + size.y));
 			}
 		}
 
-		void resizeFromCenter(hPoint size) {
+		constexpr void resizeFromCenter(ITuple<T> size) {
 			resizeFromCenter(size.x, size.y);
 		}
 
-		void resizeFromCenter(hType_u size) {
+		constexpr void resizeFromCenter(hType_u size) {
 			resizeFromCenter(size, size);
 		}
 
-		void resizeFromCenter(hType_u w, hType_u h) {
+		constexpr void resizeFromCenter(hType_u w, hType_u h) {
 			if (valid()) {
-				hPoint ctr = center();
+				ITuple<T> ctr = center();
 				resize(ctr.x - w / 2, ctr.y - h / 2, x1 + w, y1 + h);
 			}
 		}
 
-		hArea normalized() const {
-			return hArea(0, 0, x2 - x1, y2 - y1);
+		constexpr IArea normalized() const {
+			return IArea(T(0), T(0), x2 - x1, y2 - y1);
 		}
 
-		hPoint clamp(const hPoint& pt) const {
+		constexpr ITuple<T> clamp(const ITuple<T>& pt) const {
 			return { std::min(x2, std::max(x1, pt.x)), std::min(y2, std::max(y1, pt.y)) };
 		}
 
-		hPoint wrap(const hPoint& pt) const {
-			hType_i x = ((hType_i)width() + ((pt.x - x1) % (hType_i)width())) % (hType_i)width() + x1;
-			hType_i y = ((hType_i)height() + ((pt.y - y1) % (hType_i)height())) % (hType_i)height() + y1;
+		constexpr ITuple<T> wrap(const ITuple<T>& pt) const {
+			T x = ((T)width() + ((pt.x - x1) % (T)width())) % (T)width() + x1;
+			T y = ((T)height() + ((pt.y - y1) % (T)height())) % (T)height() + y1;
 			return { x, y };
 		}
 
-		std::size_t width() const {
-			return std::max(x2 - x1, 0_hi);
+		/// The width is computed with unsigned arithmetic so that spans wider than the positive range of T do not overflow.
+		/// Spans and the <see cref="area"/> are returned as <c>std::size_t</c>, so they are limited to its range (2^32 - 1 on 32-bit targets).
+		constexpr std::size_t width() const {
+			using U = std::make_unsigned_t<T>;
+			return x2 > x1 ? static_cast<std::size_t>(static_cast<U>(x2) - static_cast<U>(x1)) : 0;
 		}
 
-		std::size_t height() const {
-			return std::max(y2 - y1, 0_hi);
+		constexpr std::size_t height() const {
+			using U = std::make_unsigned_t<T>;
+			return y2 > y1 ? static_cast<std::size_t>(static_cast<U>(y2) - static_cast<U>(y1)) : 0;
 		}
 
-		hPoint dimensions() const {
+		constexpr ITuple<T> dimensions() const {
 			return { width(), height() };
 		}
 
-		hPoint first() const {
-			return { x1, x1 };
+		constexpr ITuple<T> first() const {
+			return { x1, y1 };
 		}
 
-		hPoint last() const {
+		constexpr ITuple<T> last() const {
 			return { x2, y2 };
 		}
 
-		std::size_t area() const {
+		constexpr std::size_t area() const {
 			return width() * height();
 		}
 
-		hPoint corner(int i) const {
+		constexpr ITuple<T> corner(int i) const {
 			switch (i) {
 			case(H_CORNER_TOPLEFT):
 				return { x1, y1 };
@@ -563,34 +666,40 @@ namespace hrzn {
 			}
 		}
 
-		hPoint center() const {
+		constexpr ITuple<T> center() const {
 			return { (x2 - x1) / 2 + x1, (y2 - y1) / 2 + y1 };
 		}
 
-		bool contains(const hPoint& pt) const {
+		constexpr bool contains(const ITuple<T>& pt) const {
 			return this->contains(pt.x, pt.y);
 		}
 
-		bool contains(hType_i x, hType_i y) const {
+		constexpr bool contains(T x, T y) const {
 			return x >= x1 && x < x2 && y >= y1 && y < y2;
 		}
 
-		bool contains(const hArea& other) {
-			return false;
+		constexpr bool contains(const IArea& other) const {
+			return other.x1 >= x1 && other.y1 >= y1 && other.x2 <= x2 && other.y2 <= y2;
 		}
 
-	}; // struct hArea
+	}; // struct IArea<T>
+
+	/// Type alias for areas of INT type.
+	using hArea = IArea<hType_i>;
 
-	inline bool operator==(const hArea& a, const hArea& b) {
+	template <typename T>
+	constexpr bool operator==(const IArea<T>& a, const IArea<T>& b) {
 		return a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2;
 	}
 
-	inline hArea operator+(const hArea& a, const hPoint& b) {
-		return hArea(a.first() + b, a.last() + b);
+	template <typename T>
+	constexpr IArea<T> operator+(const IArea<T>& a, const ITuple<T>& b) {
+		return IArea<T>(a.first() + b, a.last() + b);
 	}
 
-	inline hArea intersect(const hArea& a, const hArea& b) {
-		return hArea(std::max(a.x1, b.x1), std::max(a.y1, b.y1), std::min(a.x2, b.x2), std::min(a.y2, b.y2));
+	template <typename T>
+	constexpr IArea<T> intersect(const IArea<T>& a, const IArea<T>& b) {
+		return IArea<T>(std::max(a.x1, b.x1), std::max(a.y1, b.y1), std::min(a.x2, b.x2), std::min(a.y2, b.y2));
 	}
 
 
@@ -612,25 +721,25 @@ namespace hrzn {
 
 		bool repeat_boundary = false;
 
-		IMap(const hArea& area) : hArea(area) {}
+		constexpr IMap(const hArea& area) : hArea(area) {}
 
-		virtual ~IMap() {}
+		constexpr virtual ~IMap() {}
 
 		// Common inherited methods
-		T& operator[](hPoint pt) { return at(pt.x, pt.y); }
-		T operator[](hPoint pt) const { return at(pt.x, pt.y); }
+		constexpr T& operator[](hPoint pt) { return at(pt.x, pt.y); }
+		constexpr T operator[](hPoint pt) const { return at(pt.x, pt.y); }
 
-		T& at(hPoint p) { return at(p.x, p.y); }
-		T at(hPoint p) const { return at(p.x, p.y); }
-		void set(hPoint p, const T& val) { set(p.x, p.y, val); }
+		constexpr T& at(hPoint p) { return at(p.x, p.y); }
+		constexpr T at(hPoint p) const { return at(p.x, p.y); }
+		constexpr void set(hPoint p, const T& val) { set(p.x, p.y, val); }
 
-		virtual void fill(const T& obj) {
+		constexpr virtual void fill(const T& obj) {
 			for (hType_i y = y1; y < y2; ++y)
 				for (hType_i x = x1; x < x2; ++x)
 					set(x, y, obj);
 		}
 
-		void fill(fill_func f) {
+		constexpr void fill(fill_func f) {
 			for (hType_i y = y1; y < y2; ++y)
 				for (hType_i x = x1; x < x2; ++x)
 					set(x, y, f());
@@ -642,10 +751,27 @@ namespace hrzn {
 		virtual T at(hType_i x, hType_i y) const = 0;
 		virtual void set(hType_i x, hType_i y, const T& val) = 0;
 
+		/// <summary>
+		/// Pointer to the cell (x1, y) of a contiguous row, so that cell (x, y) is at <c>row(y)[x - x1]</c>.
+		/// Maps without direct storage return nullptr and are accessed through <c>at()</c> instead.
+		/// </summary>
+		constexpr virtual T* row(hType_i) { return nullptr; }
+		constexpr virtual const T* row(hType_i) const { return nullptr; }
+
 	protected:
-		std::size_t f_index(hType_i x, hType_i y) const {
+		/// <summary>
+		/// Offset of the first cell in row <paramref name="y"/>. Row offsets are computed in <c>std::size_t</c> so that maps with
+		/// more than 2^31 cells index correctly, while column offsets within a row stay in <c>hType_i</c>.
+		/// </summary>
+		constexpr std::size_t f_row(hType_i y) const {
+			using U = std::make_unsigned_t<hType_i>;
+			return static_cast<std::size_t>(static_cast<U>(y) - static_cast<U>(y1)) * width();
+		}
+
+		constexpr std::size_t f_index(hType_i x, hType_i y) const {
+			using U = std::make_unsigned_t<hType_i>;
 			if (contains(x, y))
-				return (x - x1) + (y - y1) * width();
+				return f_row(y) + static_cast<std::size_t>(static_cast<U>(x) - static_cast<U>(x1));
 			throw std::out_of_range("Point not located in Matrix.");
 		}
 
@@ -677,7 +803,7 @@ namespace hrzn {
 
 		}; // struct IMap>T>::Iterator
 
-		Iterator begin() { return Iterator(*this, { x1, x1 }); }
+		Iterator begin() { return Iterator(*this, { x1, y1 }); }
 		Iterator end() { return Iterator(*this, { x1, y2 }); }
 
 	}; // class IMap<T>
@@ -710,6 +836,18 @@ namespace hrzn {
 
 		base* source() { return m_source; }
 
+		/// Rows are shared with the source map when it has direct storage and fully contains this reference.
+		T* row(hType_i y) override {
+			T* r = m_source->contains(static_cast<const hArea&>(*this)) ? m_source->row(y) : nullptr;
+			return r ? r + (this->x1 - m_source->x1) : nullptr;
+		}
+
+		const T* row(hType_i y) const override {
+			const base* src = m_source;
+			const T* r = src->contains(static_cast<const hArea&>(*this)) ? src->row(y) : nullptr;
+			return r ? r + (this->x1 - src->x1) : nullptr;
+		}
+
 		void resize(hType_i xa, hType_i ya, hType_i xb, hType_i yb) override {
 			hArea new_rect = intersect(*this, { xa, ya, xb, yb });
 			hArea::resize(new_rect.x1, new_rect.y1, new_rect.x2, new_rect.y2);
@@ -746,9 +884,9 @@ namespace hrzn {
 
 		HMap() : base(hArea()) {}
 		HMap(std::size_t w, std::size_t h) : base(hArea(w, h)), m_contents(new T[w * h]) {}
-		HMap(std::size_t w, std::size_t h, const T& obj) : base(hArea(w, h)), m_contents(new T[w * h]) { for (int i = 0; i < (w * h); ++i) m_contents[i] = obj; }
+		HMap(std::size_t w, std::size_t h, const T& obj) : base(hArea(w, h)), m_contents(new T[w * h]) { std::fill_n(m_contents, w * h, obj); }
 		HMap(const hArea& rect) : base(rect), m_contents(new T[rect.area()]) {}
-		HMap(const hArea& rect, const T& obj) : base(rect), m_contents(new T[rect.area()]) { for (int i = 0; i < rect.area(); ++i) m_contents[i] = obj; }
+		HMap(const hArea& rect, const T& obj) : base(rect), m_contents(new T[rect.area()]) { std::fill_n(m_contents, rect.area(), obj); }
 
 		HMap(const HMap<T>& other) : base(other), m_contents(new T[other.area()]) {
 			std::copy(other.m_contents, other.m_contents + other.area(), m_contents);
@@ -775,6 +913,24 @@ namespace hrzn {
 
 		const T& operator[](std::size_t i) const { return m_contents[i]; }
 
+		T* data() { return m_contents; }
+
+		const T* data() const { return m_contents; }
+
+		/// Pointer to the first cell of row <paramref name="y"/>. Cell (x, y) is at <c>row(y)[x - x1]</c>.
+		T* row(hType_i y) override {
+			assert(y >= this->y1 && y < this->y2);
+			return m_contents + this->f_row(y);
+		}
+
+		const T* row(hType_i y) const override {
+			assert(y >= this->y1 && y < this->y2);
+			return m_contents + this->f_row(y);
+		}
+
+		/// Distance in cells between the starts of two consecutive rows.
+		std::size_t stride() const { return this->width(); }
+
 		T& at(hType_i x, hType_i y) override {
 			return m_contents[this->f_index(x, y)];
 		}
@@ -794,53 +950,196 @@ namespace hrzn {
 		void resize(hType_i xa, hType_i ya, hType_i xb, hType_i yb, const T& fill_obj) {
 			assert(m_contents != nullptr);
 			hArea new_rect(xa, ya, xb, yb);
-				T* new_block = new T[new_rect.area()];
-				for (hType_i y = new_rect.y1; y < new_rect.y2; ++y)
-					for (hType_i x = new_rect.x1; x < new_rect.x2; ++x) {
-						hType_i i = (x - new_rect.x1) + (y - new_rect.y1) * (hType_i)new_rect.width();
-						new_block[i] = hArea::contains(x, y) ? std::move(m_contents[base::f_index(x, y)]) : fill_obj;
-					}
-				delete[]m_contents;
-				m_contents = new_block;
+			T* new_block = new T[new_rect.area()];
+			T* dst = new_block;
+			for (hType_i y = new_rect.y1; y < new_rect.y2; ++y, dst += new_rect.width()) {
+				T* src = (y >= this->y1 && y < this->y2) ? row(y) : nullptr;
+				for (hType_i x = new_rect.x1; x < new_rect.x2; ++x)
+					dst[x - new_rect.x1] = (src && x >= this->x1 && x < this->x2) ? std::move(src[x - this->x1]) : fill_obj;
+			}
+			delete[]m_contents;
+			m_contents = new_block;
 			hArea::resize(new_rect.x1, new_rect.y1, new_rect.x2, new_rect.y2);
 		}
 
 	}; // class HMap<T>
 
 
+	/// <summary>
+	/// Map container with dimensions fixed at compile time. The contents are stored inline, so the map can be filled and
+	/// read in constant expressions, e.g. to generate prefab rooms or lookup tables at compile time.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template <typename T, std::size_t W, std::size_t H>
+	class HMapStatic : public IMap<T> {
+	public:
+
+		using IMap<T>::operator[];
+		using IMap<T>::at;
+		using IMap<T>::set;
+		using base = IMap<T>;
+
+	private:
+
+		std::array<T, W * H> m_contents{};
+
+	public:
+
+		constexpr HMapStatic() : base(hArea(W, H)) {}
+		constexpr HMapStatic(const T& obj) : base(hArea(W, H)) { m_contents.fill(obj); }
+		constexpr HMapStatic(const std::array<T, W * H>& contents) : base(hArea(W, H)), m_contents(contents) {}
+		constexpr HMapStatic(hPoint offset, const T& obj) : base(hArea(offset.x, offset.y, offset.x + (hType_i)W, offset.y + (hType_i)H)) { m_contents.fill(obj); }
+
+		constexpr ~HMapStatic() override {}
+
+		constexpr operator bool() const override { return true; }
+
+		constexpr T& operator[](std::size_t i) { return m_contents[i]; }
+
+		constexpr const T& operator[](std::size_t i) const { return m_contents[i]; }
+
+		constexpr T& at(hType_i x, hType_i y) override {
+			return m_contents[this->f_index(x, y)];
+		}
+
+		constexpr T at(hType_i x, hType_i y) const override {
+			return m_contents[this->f_index(x, y)];
+		}
+
+		constexpr void set(hType_i x, hType_i y, const T& val) override {
+			m_contents[this->f_index(x, y)] = val;
+		}
+
+		constexpr void fill(const T& obj) override {
+			m_contents.fill(obj);
+		}
+
+		/// The storage can not grow, so only moves that keep the dimensions are accepted.
+		constexpr void resize(hType_i xa, hType_i ya, hType_i xb, hType_i yb) override {
+			hArea new_rect(std::min(xa, xb), std::min(ya, yb), std::max(xa, xb), std::max(ya, yb));
+			if (new_rect.width() != W || new_rect.height() != H)
+				throw std::length_error("A static map can not change its dimensions.");
+			hArea::resize(xa, ya, xb, yb);
+		}
+
+		constexpr const std::array<T, W * H>& contents() const { return m_contents; }
+
+		constexpr T* data() { return m_contents.data(); }
+
+		constexpr const T* data() const { return m_contents.data(); }
+
+		constexpr T* row(hType_i y) override { return m_contents.data() + this->f_row(y); }
+
+		constexpr const T* row(hType_i y) const override { return m_contents.data() + this->f_row(y); }
+
+		constexpr std::size_t stride() const { return W; }
+
+	}; // class HMapStatic<T, W, H>
+
+
+	/// <summary>
+	/// Call <paramref name="fn"/> once per cell of the intersection of <paramref name="area"/> and every map, passing the cell of
+	/// each map in order. The intersection is computed once, and each map is walked with its own row pointer, so maps with
+	/// different origins line up without per-cell index math. Rows of maps without direct storage fall back to <c>at()</c>.
+	/// </summary>
+	/// <example><code>zipForEach(a, [](float&amp; out, const float&amp; x, const bool&amp; m) { out = m ? x : out; }, a, b, mask);</code></example>
+	template <typename TFunc, typename... TMaps>
+	inline void zipForEach(hArea area, TFunc&& fn, TMaps&... maps) {
+		static_assert(sizeof...(TMaps) > 0, "At least one map is required.");
+		((area = intersect(area, static_cast<const hArea&>(maps))), ...);
+		if (!area.valid())
+			return;
+
+		// Row lengths and column offsets are kept in std::size_t, as spans may exceed the positive range of hType_i
+		using U = std::make_unsigned_t<hType_i>;
+		const std::size_t w = area.width();
+		for (hType_i y = area.y1; y < area.y2; ++y) {
+			auto rows = std::make_tuple(maps.row(y)...);
+			const bool direct = std::apply([](auto... r) { return ((r != nullptr) && ...); }, rows);
+			if (direct) {
+				auto cells = std::apply([&](auto... r) {
+					return std::make_tuple((r + static_cast<std::size_t>(static_cast<U>(area.x1) - static_cast<U>(maps.x1)))...);
+				}, rows);
+				std::apply([&](auto... c) {
+					for (std::size_t i = 0; i < w; ++i)
+						fn(c[i]...);
+				}, cells);
+			}
+			else {
+				for (hType_i x = area.x1; x < area.x2; ++x)
+					fn(maps.at(x, y)...);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Check <paramref name="pred"/> on every cell of the intersection of <paramref name="area"/> and every map, walking them as
+	/// <see cref="zipForEach"/> does. Rows with direct storage are tested as a whole without branching, and the walk stops after
+	/// the first row holding a cell that fails.
+	/// </summary>
+	/// <returns>True if the predicate holds for every cell, including when the intersection is empty.</returns>
+	template <typename TPred, typename... TMaps>
+	inline bool zipAllOf(hArea area, TPred&& pred, TMaps&... maps) {
+		static_assert(sizeof...(TMaps) > 0, "At least one map is required.");
+		((area = intersect(area, static_cast<const hArea&>(maps))), ...);
+		if (!area.valid())
+			return true;
+
+		// Row lengths and column offsets are kept in std::size_t, as spans may exceed the positive range of hType_i
+		using U = std::make_unsigned_t<hType_i>;
+		const std::size_t w = area.width();
+		for (hType_i y = area.y1; y < area.y2; ++y) {
+			auto rows = std::make_tuple(maps.row(y)...);
+			const bool direct = std::apply([](auto... r) { return ((r != nullptr) && ...); }, rows);
+			if (direct) {
+				auto cells = std::apply([&](auto... r) {
+					return std::make_tuple((r + static_cast<std::size_t>(static_cast<U>(area.x1) - static_cast<U>(maps.x1)))...);
+				}, rows);
+				const bool ok = std::apply([&](auto... c) {
+					bool all = true;
+					for (std::size_t i = 0; i < w; ++i)
+						all &= static_cast<bool>(pred(c[i]...));
+					return all;
+				}, cells);
+				if (!ok)
+					return false;
+			}
+			else {
+				for (hType_i x = area.x1; x < area.x2; ++x) {
+					if (!pred(maps.at(x, y)...))
+						return false;
+				}
+			}
+		}
+		return true;
+	}
+
+
 	// Bitwise AND operation between two boolean Matrices
 	inline HMap<bool> operator & (const IMap<bool>& a, const IMap<bool>& b) {
 		HMap<bool> result(intersect(a, b));
-		for (int y = result.y1; y < result.y2; ++y)
-			for (int x = result.x1; x < result.x2; ++x)
-				result.set(x, y, a.at(x, y) && b.at(x, y));
+		zipForEach(result, [](bool& r, bool x, bool y) { r = x && y; }, result, a, b);
 		return result;
 	}
 
 	// Bitwise OR operation between two boolean Matrices
 	inline HMap<bool> operator | (const IMap<bool>& a, const IMap<bool>& b) {
 		HMap<bool> result(intersect(a, b));
-		for (int y = result.y1; y < result.y2; ++y)
-			for (int x = result.x1; x < result.x2; ++x)
-				result.set(x, y, a.at(x, y) || b.at(x, y));
+		zipForEach(result, [](bool& r, bool x, bool y) { r = x || y; }, result, a, b);
 		return result;
 	}
 
 	// Bitwise XOR operation between two boolean Matrices
 	inline HMap<bool> operator ^ (const IMap<bool>& a, const IMap<bool>& b) {
 		HMap<bool> result(intersect(a, b));
-		for (int y = result.y1; y < result.y2; ++y)
-			for (int x = result.x1; x < result.x2; ++x)
-				result.set(x, y, a.at(x, y) && b.at(x, y));
+		zipForEach(result, [](bool& r, bool x, bool y) { r = x != y; }, result, a, b);
 		return result;
 	}
 
 	// Bitwise Invert operation between on a boolean Matrix
 	inline HMap<bool> operator ~ (const IMap<bool>& a) {
 		HMap<bool> result((hArea)a);
-		for (int y = a.y1; y < a.y2; ++y)
-			for (int x = a.x1; x < a.x2; ++x)
-				result.set(x, y, !a.at(x, y));
+		zipForEach(result, [](bool& r, bool x) { r = !x; }, result, a);
 		return result;
 	}
 
@@ -853,44 +1152,237 @@ namespace hrzn {
 	/// <summary>
 	/// A class holding position, rotation, and scale values for use in transformation of various other coordinates in 2D space.
 	/// </summary>
-	struct hTransform {
-		hVector position;
-		hRotation rotation;
-		hVector scale;
+	/// <typeparam name="T">Floating point type of the components.</typeparam>
+	template <typename T>
+	struct ITransform {
+		ITuple<T> position;
+		IRotation<T> rotation;
+		ITuple<T> scale;
 
-		constexpr hTransform() : position(0._hf, 0._hf), rotation(0._hf), scale(1._hf, 1._hf) {}
+		constexpr ITransform() : position(T(0), T(0)), rotation(T(0)), scale(T(1), T(1)) {}
 
-		constexpr hTransform(hVector p, hRotation r, hVector s) : position(p), rotation(r), scale(s) {}
+		constexpr ITransform(ITuple<T> p, IRotation<T> r, ITuple<T> s) : position(p), rotation(r), scale(s) {}
+
+		template <typename TCast>
+		explicit constexpr ITransform(const ITransform<TCast>& other) : position(other.position), rotation(other.rotation), scale(other.scale) {}
 
-		hVector getForwardVector() const {
+		ITuple<T> getForwardVector() const {
 			return rotation.getForwardVector(scale.y);
 		}
 
-		hVector getRightVector() const {
+		ITuple<T> getRightVector() const {
 			return rotation.getRightVector(scale.x);
 		}
 
-		hVector childPositon(hVector pos) const {
+		ITuple<T> childPositon(ITuple<T> pos) const {
 			return position + rotation.rotate(pos * scale);
 		}
 
-		hRotation childRotation(hRotation r) const {
+		IRotation<T> childRotation(IRotation<T> r) const {
 			return rotation + r;
 		}
 
-		hVector childScale(hVector s) const {
+		ITuple<T> childScale(ITuple<T> s) const {
 			return scale * s;
 		}
 
-		hVector inversePosition(hVector pos) {
+		ITuple<T> inversePosition(ITuple<T> pos) {
 			return rotation.unrotate(pos / scale.epsilon()) - pos;
 		}
 
-		hTransform childTransform(const hTransform & child) const {
+		ITransform childTransform(const ITransform & child) const {
 			return { childPositon(child.position), childRotation(child.rotation), childScale(child.scale)};
 		}
 
-	}; // struct hTransform
+	}; // struct ITransform<T>
+
+	/// Type alias for transforms of FLOAT type.
+	using hTransform = ITransform<hType_f>;
+
+
+	/// <summary>
+	/// A 2x3 affine matrix baked from a transform. Applying it to a point costs four multiply-adds with no trigonometry.
+	/// </summary>
+	/// <typeparam name="T">Floating point type of the matrix.</typeparam>
+	template <typename T>
+	struct IAffine {
+		ITuple<T> axis_x;
+		ITuple<T> axis_y;
+		ITuple<T> origin;
+
+		constexpr IAffine() : axis_x(T(1), T(0)), axis_y(T(0), T(1)), origin(T(0), T(0)) {}
+
+		constexpr IAffine(ITuple<T> ax, ITuple<T> ay, ITuple<T> o) : axis_x(ax), axis_y(ay), origin(o) {}
+
+		/// <summary>
+		/// Bake a transform into a matrix. Produces the same results as <c>ITransform::childPositon()</c>.
+		/// </summary>
+		explicit IAffine(const ITransform<T>& tform) {
+			T a = tform.rotation.angle().rad();
+			T c = std::cos(a);
+			T s = std::sin(a);
+			axis_x = { c * tform.scale.x, s * tform.scale.x };
+			axis_y = { -s * tform.scale.y, c * tform.scale.y };
+			origin = tform.position;
+		}
+
+		constexpr ITuple<T> apply(ITuple<T> v) const {
+			return { origin.x + axis_x.x * v.x + axis_y.x * v.y, origin.y + axis_x.y * v.x + axis_y.y * v.y };
+		}
+
+		constexpr ITuple<T> applyDirection(ITuple<T> v) const {
+			return { axis_x.x * v.x + axis_y.x * v.y, axis_x.y * v.x + axis_y.y * v.y };
+		}
+
+		constexpr T determinant() const {
+			return axis_x.x * axis_y.y - axis_y.x * axis_x.y;
+		}
+
+		/// <summary>
+		/// Find the inverse matrix. A degenerate matrix (zero scale) returns the identity.
+		/// </summary>
+		constexpr IAffine inverse() const {
+			T det = determinant();
+			if ((det < T(0) ? -det : det) < vEpsilon<T>::value)
+				return IAffine();
+			T id = T(1) / det;
+			ITuple<T> ix = { axis_y.y * id, -axis_x.y * id };
+			ITuple<T> iy = { -axis_y.x * id, axis_x.x * id };
+			ITuple<T> io = { -(ix.x * origin.x + iy.x * origin.y), -(ix.y * origin.x + iy.y * origin.y) };
+			return { ix, iy, io };
+		}
+
+		/// <summary>
+		/// Transform a list of points. The input and output may be the same span.
+		/// </summary>
+		/// <param name="in">Points to be transformed.</param>
+		/// <param name="out">Destination for the transformed points. Must be at least as large as <paramref name="in"/>.</param>
+		void transform(std::span<const ITuple<T>> in, std::span<ITuple<T>> out) const {
+			assert(out.size() >= in.size());
+			const T ax = axis_x.x, ay = axis_x.y, bx = axis_y.x, by = axis_y.y, ox = origin.x, oy = origin.y;
+			const ITuple<T>* src = in.data();
+			ITuple<T>* dst = out.data();
+			const std::size_t n = in.size();
+			for (std::size_t i = 0; i < n; ++i) {
+				const T x = src[i].x;
+				const T y = src[i].y;
+				dst[i].x = ox + ax * x + bx * y;
+				dst[i].y = oy + ay * x + by * y;
+			}
+		}
+
+		void transform(std::span<ITuple<T>> points) const {
+			transform(std::span<const ITuple<T>>(points), points);
+		}
+
+		/// Compose two matrices so that the result applies <paramref name="b"/> first and then <paramref name="a"/>.
+		friend constexpr IAffine operator * (const IAffine& a, const IAffine& b) {
+			return { a.applyDirection(b.axis_x), a.applyDirection(b.axis_y), a.apply(b.origin) };
+		}
+
+	}; // struct IAffine<T>
+
+	/// Type alias for affine matrices of FLOAT type.
+	using hAffine = IAffine<hType_f>;
+
+	/// <summary>
+	/// A non-owning, non-virtual view over a contiguous list of polygon vertices.
+	/// </summary>
+	/// <typeparam name="T">Numeric type of the vertices.</typeparam>
+	template <typename T>
+	struct IPolygonView {
+		std::span<const ITuple<T>> vertices;
+
+		constexpr IPolygonView() {}
+		constexpr IPolygonView(std::span<const ITuple<T>> verts) : vertices(verts) {}
+
+		constexpr std::size_t count() const { return vertices.size(); }
+		constexpr ITuple<T> get(std::size_t index) const { return vertices[index]; }
+
+		constexpr ITuple<T> operator[](std::size_t index) const { return vertices[index]; }
+
+	}; // struct IPolygonView<T>
+
+	/// Type alias for polygon views over FLOAT vertices.
+	using hPolygonView = IPolygonView<hType_f>;
+
+
+	/// <summary>
+	/// Polygon algorithms shared by all polygon types. Any type with <c>count()</c> and <c>get()</c> can be used, and
+	/// with <c>IPolygonView</c> every vertex access is a plain array read. Results use the vertex type of the polygon.
+	/// </summary>
+	namespace polygon {
+
+		/// The vertex type returned by <c>TPolygon::get()</c>.
+		template <typename TPolygon>
+		using vertex_t = std::decay_t<decltype(std::declval<const TPolygon&>().get(0))>;
+
+		/// The scalar type of the vertices of <c>TPolygon</c>.
+		template <typename TPolygon>
+		using scalar_t = decltype(vertex_t<TPolygon>::x);
+
+		template <typename TPolygon>
+		inline std::vector<vertex_t<TPolygon>> list(const TPolygon& poly) {
+			const std::size_t n = poly.count();
+			std::vector<vertex_t<TPolygon>> list;
+			list.reserve(n);
+			for (std::size_t i = 0; i < n; ++i)
+				list.emplace_back(poly.get(i));
+			return list;
+		}
+
+		template <typename TPolygon>
+		inline vertex_t<TPolygon> center(const TPolygon& poly) {
+			const std::size_t n = poly.count();
+			vertex_t<TPolygon> avg;
+			for (std::size_t i = 0; i < n; ++i)
+				avg += poly.get(i);
+			return avg / static_cast<scalar_t<TPolygon>>(n);
+		}
+
+		template <typename TPolygon>
+		inline scalar_t<TPolygon> perimeter(const TPolygon& poly) {
+			using S = scalar_t<TPolygon>;
+			const std::size_t n = poly.count();
+			if (n < 2)
+				return S(0);
+			S length = S(0);
+			vertex_t<TPolygon> prev = poly.get(0);
+			for (std::size_t i = 1; i < n; ++i) {
+				vertex_t<TPolygon> next = poly.get(i);
+				length += static_cast<S>((prev - next).length());
+				prev = next;
+			}
+			return length;
+		}
+
+		template <typename TPolygon>
+		inline scalar_t<TPolygon> perimeterClosed(const TPolygon& poly) {
+			using S = scalar_t<TPolygon>;
+			const std::size_t n = poly.count();
+			if (n < 2)
+				return S(0);
+			return perimeter(poly) + static_cast<S>((poly.get(0) - poly.get(n - 1)).length());
+		}
+
+		/// <summary>
+		/// Find the signed area of a polygon. Positive when the vertices wind counter-clockwise with y pointing up.
+		/// </summary>
+		template <typename TPolygon>
+		inline scalar_t<TPolygon> signedArea(const TPolygon& poly) {
+			using S = scalar_t<TPolygon>;
+			const std::size_t n = poly.count();
+			S area = S(0);
+			for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+				vertex_t<TPolygon> a = poly.get(j);
+				vertex_t<TPolygon> b = poly.get(i);
+				area += a.x * b.y - b.x * a.y;
+			}
+			return area / S(2);
+		}
+
+	} // namespace polygon
+
 
 	struct IPolygon {
 
@@ -900,35 +1392,42 @@ namespace hrzn {
 		virtual std::size_t count() const = 0;
 		virtual hVector get(std::size_t index) const = 0;
 
+		/// <summary>
+		/// Write every vertex into a caller provided buffer.
+		/// </summary>
+		/// <param name="out">Destination buffer. Must hold at least <c>count()</c> vertices.</param>
+		/// <returns>The number of vertices written.</returns>
+		virtual std::size_t emit(std::span<hVector> out) const {
+			const std::size_t n = count();
+			assert(out.size() >= n);
+			for (std::size_t i = 0; i < n; ++i)
+				out[i] = get(i);
+			return n;
+		}
+
+		/// <summary>
+		/// Emit the vertices into a buffer and get a view over them for use with the <c>polygon</c> algorithms.
+		/// </summary>
+		hPolygonView view(std::span<hVector> buffer) const {
+			return hPolygonView(buffer.first(emit(buffer)));
+		}
+
 		hVector operator[](std::size_t index) const { return get(index); }
 
 		std::vector<hVector> list() const {
-			std::vector<hVector> list;
-			for (int i = 0; i < count(); ++i)
-				list.emplace_back(get(i));
-			return list;
+			return polygon::list(*this);
 		}
 
 		hVector center() const {
-			hVector avg;
-			for (int i = 0; i < count(); ++i)
-				avg += get(i);
-			return avg / static_cast<hType_f>(count());
+			return polygon::center(*this);
 		}
 
 		hType_f perimeter() const {
-			hType_f length = 0._hf;
-			for (int i = 0; i < count() - 1; ++i)
-				length += (get(i) - get(i + 1)).length();
-			return length;
+			return polygon::perimeter(*this);
 		}
 
 		hType_f perimeter_closed() const {
-			hType_f length = 0._hf;
-			for (int i = 0; i < count() - 1; ++i)
-				length += (get(i) - get(i + 1)).length();
-			length += (get(0) - get(count() - 1)).length();
-			return length;
+			return polygon::perimeterClosed(*this);
 		}
 
 	}; // struct IPolygon
@@ -941,11 +1440,56 @@ namespace hrzn {
 		hPolygon(std::initializer_list<hVector> verts) : vertices(verts) {}
 		hPolygon(const IPolygon & polygon) : vertices(polygon.list()) {}
 
+		using IPolygon::view;
+
 		std::size_t count() const override { return vertices.size(); }
-		hVector get(std::size_t index) const { return vertices[index]; }
+		hVector get(std::size_t index) const override { return vertices[index]; }
+
+		std::size_t emit(std::span<hVector> out) const override {
+			assert(out.size() >= vertices.size());
+			std::copy(vertices.begin(), vertices.end(), out.begin());
+			return vertices.size();
+		}
+
+		/// Get a view directly over the stored vertices.
+		hPolygonView view() const { return hPolygonView(vertices); }
+
+		operator hPolygonView() const { return view(); }
 	}; // struct hPolygon
 
 
+	/// <summary>
+	/// Storage for many polygons in one shared vertex list. Polygon <c>i</c> occupies the vertices from
+	/// <c>offsets[i]</c> up to <c>offsets[i + 1]</c>.
+	/// </summary>
+	/// <typeparam name="T">Numeric type of the vertices.</typeparam>
+	template <typename T>
+	struct IPolygonArena {
+		std::vector<ITuple<T>> vertices;
+		std::vector<std::size_t> offsets = { 0 };
+
+		std::size_t size() const { return offsets.size() - 1; }
+
+		void clear() {
+			vertices.clear();
+			offsets.assign(1, 0);
+		}
+
+		void push_back(IPolygonView<T> poly) {
+			vertices.insert(vertices.end(), poly.vertices.begin(), poly.vertices.end());
+			offsets.push_back(vertices.size());
+		}
+
+		IPolygonView<T> operator[](std::size_t i) const {
+			return IPolygonView<T>(std::span<const ITuple<T>>(vertices).subspan(offsets[i], offsets[i + 1] - offsets[i]));
+		}
+
+	}; // struct IPolygonArena<T>
+
+	/// Type alias for polygon arenas of FLOAT vertices.
+	using hPolygonArena = IPolygonArena<hType_f>;
+
+
 	template <unsigned int N>
 	struct IPolygonN : public IPolygon {
 		std::size_t count() const override { return N; }
@@ -968,6 +1512,15 @@ namespace hrzn {
 			return { (&v1)[h_corner[index].x].x, (&v1)[h_corner[index].y].y };
 		}
 
+		std::size_t emit(std::span<hVector> out) const override {
+			assert(out.size() >= 4);
+			out[0] = { v1.x, v1.y };
+			out[1] = { v2.x, v1.y };
+			out[2] = { v2.x, v2.y };
+			out[3] = { v1.x, v2.y };
+			return 4;
+		}
+
 	}; // struct hBox
 
 
@@ -982,11 +1535,58 @@ namespace hrzn {
 			return position + rotation.rotate(scale * hVector(h_quad[index].x - 0.5_hf, h_quad[index].y - 0.5_hf));
 		}
 
+		std::size_t emit(std::span<hVector> out) const override {
+			assert(out.size() >= 4);
+			matrix().transform(std::span<const hVector>(h_quad, 4), out);
+			return 4;
+		}
+
+		/// <summary>
+		/// Get the matrix which maps the unit square in <c>h_quad</c> onto the corners of this quad.
+		/// </summary>
+		hAffine matrix() const {
+			hAffine m(static_cast<const hTransform&>(*this));
+			m.origin = m.apply({ -0.5_hf, -0.5_hf });
+			return m;
+		}
+
 	}; // struct hQuad
 
 
+	/// <summary>
+	/// Write the four corners of each quad into a flat list. Each quad costs one sine/cosine pair.
+	/// </summary>
+	/// <param name="quads">List of quads to transform.</param>
+	/// <param name="out">Destination for the corners. Must hold at least four vertices per quad.</param>
+	inline void transformQuads(std::span<const hQuad> quads, std::span<hVector> out) {
+		assert(out.size() >= quads.size() * 4);
+		for (std::size_t i = 0; i < quads.size(); ++i)
+			quads[i].matrix().transform(std::span<const hVector>(h_quad, 4), out.subspan(i * 4, 4));
+	}
+
+
 } // namespace hrzn
 
+
+namespace std {
+
+	/// Hash 16 bit points through their packed key. The key is mixed so that power-of-two bucket counts stay well distributed.
+	template <>
+	struct hash<hrzn::hPoint16> {
+		std::size_t operator()(const hrzn::hPoint16& p) const noexcept {
+			return static_cast<std::size_t>((std::uint64_t(hrzn::packKey(p)) * 0x9E3779B97F4A7C15ull) >> 32);
+		}
+	};
+
+	template <>
+	struct hash<hrzn::hPointU16> {
+		std::size_t operator()(const hrzn::hPointU16& p) const noexcept {
+			return static_cast<std::size_t>((std::uint64_t(hrzn::packKey(p)) * 0x9E3779B97F4A7C15ull) >> 32);
+		}
+	};
+
+} // namespace std
+
 #undef THROW_NOT_IMPLEMENTED
 
 #undef _GENERATE_MATHF
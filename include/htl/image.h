@@ -0,0 +1,280 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <bit>
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+
+namespace hrzn {
+
+	/// <summary>
+	/// An 8-bit RGB colour as stored in a binary PPM image.
+	/// </summary>
+	struct hColor {
+		std::uint8_t r = 0;
+		std::uint8_t g = 0;
+		std::uint8_t b = 0;
+
+		constexpr bool operator==(const hColor&) const = default;
+	};
+
+	/// <summary>
+	/// Colours indexed by a value normalized to [0, 255].
+	/// </summary>
+	using hPalette = std::array<hColor, 256>;
+
+	/// <summary>
+	/// Create a palette by interpolating evenly spaced colour stops.
+	/// </summary>
+	inline hPalette makePalette(std::initializer_list<hColor> stops) {
+		hPalette palette{};
+		if (stops.size() == 0)
+			return palette;
+		const hColor* s = stops.begin();
+		const std::size_t segments = stops.size() - 1;
+		for (int i = 0; i < 256; ++i) {
+			if (segments == 0) {
+				palette[i] = s[0];
+				continue;
+			}
+			const float t = static_cast<float>(i) / 255.f * static_cast<float>(segments);
+			const std::size_t k = std::min<std::size_t>(static_cast<std::size_t>(t), segments - 1);
+			const float f = t - static_cast<float>(k);
+			auto mix = [f](std::uint8_t a, std::uint8_t b) {
+				return static_cast<std::uint8_t>(static_cast<float>(a) + static_cast<float>(b - a) * f + 0.5f);
+			};
+			palette[i] = { mix(s[k].r, s[k + 1].r), mix(s[k].g, s[k + 1].g), mix(s[k].b, s[k + 1].b) };
+		}
+		return palette;
+	}
+
+	/// Palette from black to white.
+	inline const hPalette& grayPalette() {
+		static const hPalette palette = makePalette({ { 0, 0, 0 }, { 255, 255, 255 } });
+		return palette;
+	}
+
+	/// Palette from black through red and yellow to white, suited to density or cost maps.
+	inline const hPalette& heatPalette() {
+		static const hPalette palette = makePalette({ { 0, 0, 0 }, { 160, 0, 0 }, { 255, 160, 0 }, { 255, 255, 160 }, { 255, 255, 255 } });
+		return palette;
+	}
+
+	/// <summary>
+	/// Range of values mapped onto the 256 levels of an image. Values outside of it are clamped.
+	/// </summary>
+	struct hImageRange {
+		double min = 0.0;
+		double max = 1.0;
+
+		/// Level in [0, 255] of <paramref name="value"/>. NaN maps to 0.
+		template <typename T>
+		std::uint8_t level(const T& value, float scale) const {
+			const float t = ((float)value - (float)min) * scale;
+			return t > 0.f ? (t < 255.f ? (std::uint8_t)t : 255) : 0;
+		}
+
+		/// Factor applied to a value after subtracting min. Zero for an empty range.
+		float scale() const { return max > min ? (float)(255.999 / (max - min)) : 0.f; }
+	};
+
+	/// <summary>
+	/// Read row <paramref name="y"/> of a map, through its row pointer when it has one, and call <paramref name="fn"/>(x, value) with x counted from the left edge.
+	/// </summary>
+	template <typename T, typename TFunc>
+	inline void forEachRowValue(const IMap<T>& map, hType_i y, TFunc&& fn) {
+		const T* row = map.row(y);
+		if (row) {
+			for (hType_i x = 0, w = (hType_i)map.width(); x < w; ++x)
+				fn(x, row[x]);
+		}
+		else {
+			for (hType_i x = map.x1; x < map.x2; ++x)
+				fn(x - map.x1, map.at(x, y));
+		}
+	}
+
+	/// <summary>
+	/// Find the smallest and largest finite values of a map, to normalize it for export.
+	/// </summary>
+	template <typename T>
+	inline hImageRange findValueRange(const IMap<T>& map) {
+		double lo = std::numeric_limits<double>::infinity();
+		double hi = -lo;
+		for (hType_i y = map.y1; y < map.y2; ++y) {
+			T row_lo = std::numeric_limits<T>::max();
+			T row_hi = std::numeric_limits<T>::lowest();
+			bool any = false;
+			forEachRowValue(map, y, [&](hType_i, const T& v) {
+				if constexpr (std::is_floating_point_v<T>) {
+					if (!std::isfinite(v))
+						return;
+				}
+				row_lo = v < row_lo ? v : row_lo;
+				row_hi = v > row_hi ? v : row_hi;
+				any = true;
+			});
+			if (any) {
+				lo = std::min(lo, (double)row_lo);
+				hi = std::max(hi, (double)row_hi);
+			}
+		}
+		if (lo > hi)
+			return { 0.0, 0.0 };
+		return { lo, hi };
+	}
+
+	/// <summary>
+	/// Writes the pixel rows of a binary image through one reusable buffer, handing it to the stream in large blocks.
+	/// </summary>
+	class HImageWriter {
+	private:
+		std::ostream& m_output;
+		std::vector<char> m_buffer;
+		std::size_t m_used = 0;
+
+	public:
+
+		HImageWriter(std::ostream& output, std::size_t row_bytes, std::size_t block = 1 << 20)
+			: m_output(output), m_buffer(std::max(block, row_bytes)) {}
+
+		~HImageWriter() { flush(); }
+
+		void header(const std::string& text) { m_output.write(text.data(), (std::streamsize)text.size()); }
+
+		/// Space for the next <paramref name="bytes"/> bytes of output.
+		char* next(std::size_t bytes) {
+			if (m_used + bytes > m_buffer.size())
+				flush();
+			char* p = m_buffer.data() + m_used;
+			m_used += bytes;
+			return p;
+		}
+
+		void flush() {
+			if (m_used) {
+				m_output.write(m_buffer.data(), (std::streamsize)m_used);
+				m_used = 0;
+			}
+		}
+
+	}; // class HImageWriter
+
+	/// <summary>
+	/// Write a map as a binary 8-bit grayscale PGM (P5) image, normalizing values from <paramref name="range"/> to [0, 255].
+	/// The stream should be opened in binary mode.
+	/// </summary>
+	template <typename T>
+	inline std::ostream& writePGM(std::ostream& output, const IMap<T>& map, const hImageRange& range) {
+		const std::size_t width = map.width();
+		const float scale = range.scale();
+		HImageWriter writer(output, width);
+		writer.header("P5\n" + std::to_string(width) + " " + std::to_string(map.height()) + "\n255\n");
+		for (hType_i y = map.y1; y < map.y2; ++y) {
+			std::uint8_t* out = reinterpret_cast<std::uint8_t*>(writer.next(width));
+			forEachRowValue(map, y, [&](hType_i x, const T& v) { out[x] = range.level(v, scale); });
+		}
+		return output;
+	}
+
+	/// <summary>
+	/// Write a map as a binary grayscale PGM (P5) image, normalized between its smallest and largest values.
+	/// </summary>
+	template <typename T>
+	inline std::ostream& writePGM(std::ostream& output, const IMap<T>& map) {
+		return writePGM(output, map, findValueRange(map));
+	}
+
+	/// <summary>
+	/// Write a map as a binary RGB PPM (P6) image, with <paramref name="color"/> giving the <see cref="hColor"/> of each value.
+	/// The stream should be opened in binary mode.
+	/// </summary>
+	template <typename T, typename TColor>
+		requires std::is_invocable_r_v<hColor, TColor&, const T&>
+	inline std::ostream& writePPM(std::ostream& output, const IMap<T>& map, TColor&& color) {
+		const std::size_t width = map.width();
+		HImageWriter writer(output, width * 3);
+		writer.header("P6\n" + std::to_string(width) + " " + std::to_string(map.height()) + "\n255\n");
+		for (hType_i y = map.y1; y < map.y2; ++y) {
+			char* out = writer.next(width * 3);
+			forEachRowValue(map, y, [&](hType_i x, const T& v) {
+				const hColor c = color(v);
+				out[x * 3 + 0] = (char)c.r;
+				out[x * 3 + 1] = (char)c.g;
+				out[x * 3 + 2] = (char)c.b;
+			});
+		}
+		return output;
+	}
+
+	/// <summary>
+	/// Write a map as a binary RGB PPM (P6) image, looking up each value normalized from <paramref name="range"/> in <paramref name="palette"/>.
+	/// </summary>
+	template <typename T>
+	inline std::ostream& writePPM(std::ostream& output, const IMap<T>& map, const hPalette& palette, const hImageRange& range) {
+		const float scale = range.scale();
+		return writePPM(output, map, [&](const T& v) { return palette[range.level(v, scale)]; });
+	}
+
+	/// <summary>
+	/// Write a map as a binary RGB PPM (P6) image through <paramref name="palette"/>, normalized between its smallest and largest values.
+	/// </summary>
+	template <typename T>
+	inline std::ostream& writePPM(std::ostream& output, const IMap<T>& map, const hPalette& palette = heatPalette()) {
+		return writePPM(output, map, palette, findValueRange(map));
+	}
+
+	/// <summary>
+	/// Write a map as a grayscale PFM (Pf) image of 32-bit floats in native byte order, keeping the raw values.
+	/// As the format requires, rows are stored from the bottom of the map up. The stream should be opened in binary mode.
+	/// </summary>
+	template <typename T>
+	inline std::ostream& writePFM(std::ostream& output, const IMap<T>& map) {
+		static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big, "PFM requires a little or big endian platform.");
+		const std::size_t width = map.width();
+		HImageWriter writer(output, width * sizeof(float));
+		writer.header("Pf\n" + std::to_string(width) + " " + std::to_string(map.height()) +
+			(std::endian::native == std::endian::little ? "\n-1.0\n" : "\n1.0\n"));
+		for (hType_i y = map.y2; y-- > map.y1;) {
+			char* out = writer.next(width * sizeof(float));
+			forEachRowValue(map, y, [&](hType_i x, const T& v) {
+				const float f = (float)v;
+				std::memcpy(out + x * sizeof(float), &f, sizeof(float));
+			});
+		}
+		return output;
+	}
+
+} // namespace hrzn
@@ -0,0 +1,322 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <array>
+#include <tuple>
+#include <memory>
+#include <utility>
+
+namespace hrzn {
+
+	/// Layout tag storing every channel of a layered map in its own contiguous plane.
+	struct hLayoutSoA {};
+
+	/// <summary>
+	/// Layout tag storing a layered map in tiles of <typeparamref name="N"/> consecutive cells, where each tile holds the
+	/// values of every channel for those cells one after the other. Keeps all channels of a cell within a few cache lines.
+	/// </summary>
+	template <std::size_t N = 16>
+	struct hLayoutAoSoA {
+		static constexpr std::size_t tile = N;
+	};
+
+
+	template <typename TLayout, typename... Ts>
+	class HLayerStorage;
+
+	/// <summary>
+	/// Channel storage with one plane per channel.
+	/// </summary>
+	template <typename... Ts>
+	class HLayerStorage<hLayoutSoA, Ts...> {
+	public:
+
+		static constexpr bool contiguous = true;
+
+		HLayerStorage() {}
+
+		explicit HLayerStorage(std::size_t n) : m_size(n), m_planes(std::unique_ptr<Ts[]>(new Ts[n]())...) {}
+
+		HLayerStorage(const HLayerStorage& other) : HLayerStorage(other.m_size) {
+			copyPlanes(other, std::index_sequence_for<Ts...>());
+		}
+
+		HLayerStorage(HLayerStorage&& other) = default;
+
+		HLayerStorage& operator =(const HLayerStorage& other) {
+			if (this != &other)
+				*this = HLayerStorage(other);
+			return *this;
+		}
+
+		HLayerStorage& operator =(HLayerStorage&& other) = default;
+
+		std::size_t size() const { return m_size; }
+
+		template <std::size_t K>
+		auto& get(std::size_t i) { return std::get<K>(m_planes)[i]; }
+
+		template <std::size_t K>
+		const auto& get(std::size_t i) const { return std::get<K>(m_planes)[i]; }
+
+		template <std::size_t K>
+		auto* plane() { return std::get<K>(m_planes).get(); }
+
+		template <std::size_t K>
+		const auto* plane() const { return std::get<K>(m_planes).get(); }
+
+		template <typename TFunc>
+		void forEach(TFunc& fn) {
+			std::apply([this, &fn](auto&... planes) {
+				for (std::size_t i = 0; i < m_size; ++i)
+					fn(planes[i]...);
+			}, m_planes);
+		}
+
+	private:
+
+		template <std::size_t... Is>
+		void copyPlanes(const HLayerStorage& other, std::index_sequence<Is...>) {
+			(std::copy_n(std::get<Is>(other.m_planes).get(), m_size, std::get<Is>(m_planes).get()), ...);
+		}
+
+		std::size_t m_size = 0;
+		std::tuple<std::unique_ptr<Ts[]>...> m_planes;
+
+	}; // class HLayerStorage<hLayoutSoA, Ts...>
+
+	/// <summary>
+	/// Channel storage in tiles of N cells, each tile holding one array per channel.
+	/// </summary>
+	template <std::size_t N, typename... Ts>
+	class HLayerStorage<hLayoutAoSoA<N>, Ts...> {
+	public:
+
+		static constexpr bool contiguous = false;
+
+		HLayerStorage() {}
+
+		explicit HLayerStorage(std::size_t n) : m_size(n), m_tiles((n + N - 1) / N) {}
+
+		std::size_t size() const { return m_size; }
+
+		template <std::size_t K>
+		auto& get(std::size_t i) { return std::get<K>(m_tiles[i / N])[i % N]; }
+
+		template <std::size_t K>
+		const auto& get(std::size_t i) const { return std::get<K>(m_tiles[i / N])[i % N]; }
+
+		template <typename TFunc>
+		void forEach(TFunc& fn) {
+			for (std::size_t t = 0; t < m_tiles.size(); ++t) {
+				const std::size_t n = std::min(N, m_size - t * N);
+				std::apply([n, &fn](auto&... lanes) {
+					for (std::size_t i = 0; i < n; ++i)
+						fn(lanes[i]...);
+				}, m_tiles[t]);
+			}
+		}
+
+	private:
+
+		std::size_t m_size = 0;
+		std::vector<std::tuple<std::array<Ts, N>...>> m_tiles;
+
+	}; // class HLayerStorage<hLayoutAoSoA<N>, Ts...>
+
+
+	template <typename TLayered, std::size_t K>
+	class HMapLayer;
+
+	/// <summary>
+	/// A map storing several typed channels over one shared area, e.g. height, biome and moisture of a world.
+	/// Every channel of a cell is found from a single index, and <c>layer&lt;K&gt;()</c> gives an <c>IMap</c> view of one
+	/// channel for use with the map algorithms.
+	/// </summary>
+	/// <typeparam name="TLayout"><c>hLayoutSoA</c> or <c>hLayoutAoSoA&lt;N&gt;</c>.</typeparam>
+	/// <typeparam name="Ts">Types of the channels.</typeparam>
+	template <typename TLayout, typename... Ts>
+	class HMapLayered : public hArea {
+	public:
+
+		using storage_type = HLayerStorage<TLayout, Ts...>;
+
+		template <std::size_t K>
+		using channel_t = std::tuple_element_t<K, std::tuple<Ts...>>;
+
+		static constexpr std::size_t channels = sizeof...(Ts);
+
+		HMapLayered() : hArea() {}
+		HMapLayered(const hArea& area) : hArea(area), m_storage(area.area()) {}
+		HMapLayered(const hArea& area, const Ts&... values) : HMapLayered(area) { fill(values...); }
+
+		/// Linear index of a cell, shared by every channel.
+		std::size_t index(hType_i x, hType_i y) const {
+			using U = std::make_unsigned_t<hType_i>;
+			if (contains(x, y))
+				return static_cast<std::size_t>(static_cast<U>(y) - static_cast<U>(y1)) * width() + static_cast<std::size_t>(static_cast<U>(x) - static_cast<U>(x1));
+			throw std::out_of_range("Point not located in Matrix.");
+		}
+
+		template <std::size_t K>
+		channel_t<K>& get(std::size_t i) { return m_storage.template get<K>(i); }
+
+		template <std::size_t K>
+		const channel_t<K>& get(std::size_t i) const { return m_storage.template get<K>(i); }
+
+		template <std::size_t K>
+		channel_t<K>& at(hType_i x, hType_i y) { return get<K>(index(x, y)); }
+
+		template <std::size_t K>
+		const channel_t<K>& at(hType_i x, hType_i y) const { return get<K>(index(x, y)); }
+
+		/// References to every channel of a cell.
+		std::tuple<Ts&...> cell(hType_i x, hType_i y) {
+			return cellAt(index(x, y), std::index_sequence_for<Ts...>());
+		}
+
+		std::tuple<const Ts&...> cell(hType_i x, hType_i y) const {
+			return cellAt(index(x, y), std::index_sequence_for<Ts...>());
+		}
+
+		/// Pointer to the cell (x1, y) of channel <typeparamref name="K"/>, or nullptr when the layout does not keep channel rows contiguous.
+		template <std::size_t K>
+		channel_t<K>* row(hType_i y) {
+			if constexpr (storage_type::contiguous)
+				return m_storage.template plane<K>() + index(x1, y);
+			else
+				return nullptr;
+		}
+
+		template <std::size_t K>
+		const channel_t<K>* row(hType_i y) const {
+			if constexpr (storage_type::contiguous)
+				return m_storage.template plane<K>() + index(x1, y);
+			else
+				return nullptr;
+		}
+
+		template <std::size_t K>
+		void fill(const channel_t<K>& value) {
+			for (std::size_t i = 0; i < m_storage.size(); ++i)
+				m_storage.template get<K>(i) = value;
+		}
+
+		void fill(const Ts&... values) {
+			forEach([&](Ts&... cells) { ((cells = values), ...); });
+		}
+
+		/// <summary>
+		/// Call <paramref name="fn"/> with references to every channel of each cell, in storage order.
+		/// </summary>
+		template <typename TFunc>
+		void forEach(TFunc fn) {
+			m_storage.forEach(fn);
+		}
+
+		/// Get an <c>IMap</c> view of channel <typeparamref name="K"/>. The view is invalidated when the layered map is resized.
+		template <std::size_t K>
+		HMapLayer<HMapLayered, K> layer() { return HMapLayer<HMapLayered, K>(*this); }
+
+		/// Resize the area, keeping the channel values of cells inside both the old and new areas.
+		void resize(hType_i xa, hType_i ya, hType_i xb, hType_i yb) override {
+			HMapLayered next({ std::min(xa, xb), std::min(ya, yb), std::max(xa, xb), std::max(ya, yb) });
+			hArea overlap = intersect(static_cast<const hArea&>(*this), static_cast<const hArea&>(next));
+			HRZN_FOREACH_POINT(overlap, x, y) {
+				moveCell(next, index(x, y), next.index(x, y), std::index_sequence_for<Ts...>());
+			}
+			m_storage = std::move(next.m_storage);
+			hArea::resize(next.x1, next.y1, next.x2, next.y2);
+		}
+
+	private:
+
+		template <std::size_t... Is>
+		std::tuple<Ts&...> cellAt(std::size_t i, std::index_sequence<Is...>) {
+			return std::tie(m_storage.template get<Is>(i)...);
+		}
+
+		template <std::size_t... Is>
+		std::tuple<const Ts&...> cellAt(std::size_t i, std::index_sequence<Is...>) const {
+			return std::tie(m_storage.template get<Is>(i)...);
+		}
+
+		template <std::size_t... Is>
+		void moveCell(HMapLayered& to, std::size_t from_i, std::size_t to_i, std::index_sequence<Is...>) {
+			((to.m_storage.template get<Is>(to_i) = std::move(m_storage.template get<Is>(from_i))), ...);
+		}
+
+		storage_type m_storage;
+
+	}; // class HMapLayered<TLayout, Ts...>
+
+
+	/// <summary>
+	/// An <c>IMap</c> view of a single channel of a layered map. With the SoA layout its rows are exposed directly,
+	/// so <c>zipForEach</c> walks them with row pointers.
+	/// </summary>
+	template <typename TLayered, std::size_t K>
+	class HMapLayer : public IMap<typename TLayered::template channel_t<K>> {
+	public:
+
+		using T = typename TLayered::template channel_t<K>;
+		using base = IMap<T>;
+		using base::operator[];
+		using base::at;
+		using base::set;
+
+	private:
+
+		TLayered* m_source;
+
+	public:
+
+		HMapLayer(TLayered& source) : base(source), m_source(&source) {}
+
+		operator bool() const override { return m_source->area() > 0; }
+
+		T& at(hType_i x, hType_i y) override { return m_source->template at<K>(x, y); }
+
+		T at(hType_i x, hType_i y) const override { return static_cast<const TLayered*>(m_source)->template at<K>(x, y); }
+
+		void set(hType_i x, hType_i y, const T& val) override { m_source->template at<K>(x, y) = val; }
+
+		T* row(hType_i y) override { return m_source->template row<K>(y); }
+
+		const T* row(hType_i y) const override { return static_cast<const TLayered*>(m_source)->template row<K>(y); }
+
+		TLayered* source() { return m_source; }
+
+		void resize(hType_i, hType_i, hType_i, hType_i) override {
+			throw std::length_error("A layer view can not change its dimensions; resize the layered map instead.");
+		}
+
+	}; // class HMapLayer<TLayered, K>
+
+
+} // namespace hrzn
@@ -0,0 +1,315 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <string_view>
+#include <istream>
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include <utility>
+
+namespace hrzn {
+
+	/// <summary>
+	/// Lookup table converting each character of an ASCII grid to a cell value.
+	/// </summary>
+	template <typename T>
+	using hCharTable = std::array<T, 256>;
+
+	/// <summary>
+	/// Create a character table where every character maps to <paramref name="fallback"/> except the listed ones.
+	/// </summary>
+	template <typename T>
+	inline hCharTable<T> makeCharTable(const T& fallback, std::initializer_list<std::pair<char, T>> values) {
+		hCharTable<T> table;
+		table.fill(fallback);
+		for (const auto& [c, v] : values)
+			table[static_cast<unsigned char>(c)] = v;
+		return table;
+	}
+
+	/// <summary>
+	/// Call <paramref name="fn"/> with every line of <paramref name="text"/>, without the line break. Accepts both LF and CRLF
+	/// line endings. A final line break does not produce an empty trailing line.
+	/// </summary>
+	template <typename TFunc>
+	inline void forEachLine(std::string_view text, TFunc&& fn) {
+		const char* p = text.data();
+		const char* end = p + text.size();
+		while (p < end) {
+			const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			const char* stop = nl ? nl : end;
+			const char* last = (stop > p && stop[-1] == '\r') ? stop - 1 : stop;
+			fn(std::string_view(p, last - p));
+			p = nl ? nl + 1 : end;
+		}
+	}
+
+	/// <summary>
+	/// Call <paramref name="fn"/> with every line of <paramref name="input"/>, reading it in blocks of <paramref name="block"/>
+	/// bytes rather than line by line. Only a line spanning two blocks is copied.
+	/// </summary>
+	template <typename TFunc>
+	inline void forEachLine(std::istream& input, TFunc&& fn, std::size_t block = 1 << 16) {
+		std::vector<char> buffer(block);
+		std::string carry;
+		while (input) {
+			input.read(buffer.data(), (std::streamsize)buffer.size());
+			const std::size_t count = (std::size_t)input.gcount();
+			if (count == 0)
+				break;
+
+			const char* p = buffer.data();
+			const char* end = p + count;
+			const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (!nl) {
+				carry.append(p, end);
+				continue;
+			}
+
+			// Complete the line carried over from the previous block
+			if (!carry.empty()) {
+				carry.append(p, nl + 1);
+				forEachLine(std::string_view(carry), fn);
+				carry.clear();
+				p = nl + 1;
+			}
+
+			// Every complete line of this block, leaving the partial tail for the next one
+			const char* tail = end;
+			while (tail > p && tail[-1] != '\n')
+				--tail;
+			forEachLine(std::string_view(p, tail - p), fn);
+			carry.assign(tail, end);
+		}
+		if (!carry.empty())
+			forEachLine(std::string_view(carry), fn);
+	}
+
+	/// <summary>
+	/// Parse a single number in <paramref name="field"/> with <c>std::from_chars</c>, ignoring surrounding blanks and accepting a single leading sign.
+	/// </summary>
+	/// <returns>False if the field is not entirely a number representable as <typeparamref name="T"/>.</returns>
+	template <typename T>
+	inline bool parseValue(std::string_view field, T& value) {
+		const char* p = field.data();
+		const char* end = p + field.size();
+		while (p < end && (*p == ' ' || *p == '\t'))
+			++p;
+		while (end > p && (end[-1] == ' ' || end[-1] == '\t'))
+			--end;
+		if (p < end && *p == '+') {
+			++p;
+			if (p < end && (*p == '-' || *p == '+'))
+				return false;
+		}
+		if (p == end)
+			return false;
+
+		if constexpr (std::is_same_v<T, bool>) {
+			unsigned int v = 0;
+			auto res = std::from_chars(p, end, v);
+			if (res.ec != std::errc() || res.ptr != end || v > 1)
+				return false;
+			value = v != 0;
+			return true;
+		}
+		else {
+			auto res = std::from_chars(p, end, value);
+			return res.ec == std::errc() && res.ptr == end;
+		}
+	}
+
+	/// <summary>
+	/// Collects rows of cell values as they are parsed and lays them out into a map once the grid size is known.
+	/// </summary>
+	template <typename T>
+	class HGridBuilder {
+	private:
+		std::vector<T> m_values;
+		std::vector<std::size_t> m_rows;
+		std::size_t m_width = 0;
+
+	public:
+
+		HGridBuilder() { m_rows.push_back(0); }
+
+		std::size_t width() const { return m_width; }
+		std::size_t height() const { return m_rows.size() - 1; }
+
+		void push(const T& value) { m_values.push_back(value); }
+
+		/// Close the current row and return its length.
+		std::size_t endRow() {
+			const std::size_t length = m_values.size() - m_rows.back();
+			m_width = std::max(m_width, length);
+			m_rows.push_back(m_values.size());
+			return length;
+		}
+
+		/// <summary>
+		/// Build a map with its top left corner at <paramref name="origin"/>. Rows shorter than the widest one are completed with <paramref name="fill"/>.
+		/// </summary>
+		HMap<T> build(const hPoint& origin, const T& fill) const {
+			const hArea area{ origin.x, origin.y, origin.x + (hType_i)m_width, origin.y + (hType_i)height() };
+			HMap<T> map(area);
+			T* out = map.data();
+			for (std::size_t y = 0; y < height(); ++y) {
+				auto first = m_values.begin() + m_rows[y];
+				auto last = m_values.begin() + m_rows[y + 1];
+				out = std::copy(first, last, out);
+				out = std::fill_n(out, m_width - (last - first), fill);
+			}
+			return map;
+		}
+
+	}; // class HGridBuilder<T>
+
+	/// <summary>
+	/// Parses ASCII grids where each character is one cell, converted through a <see cref="hCharTable"/>.
+	/// Every line is a row; rows shorter than the widest one are completed with the value of ' '.
+	/// </summary>
+	template <typename T>
+	class HAsciiGridParser {
+	private:
+		const hCharTable<T>& m_table;
+		HGridBuilder<T> m_grid;
+
+	public:
+
+		explicit HAsciiGridParser(const hCharTable<T>& table) : m_table(table) {}
+
+		void operator()(std::string_view line) {
+			for (char c : line)
+				m_grid.push(m_table[static_cast<unsigned char>(c)]);
+			m_grid.endRow();
+		}
+
+		HMap<T> build(const hPoint& origin) const { return m_grid.build(origin, m_table[' ']); }
+
+	}; // class HAsciiGridParser<T>
+
+	/// <summary>
+	/// Parses CSV grids of numbers, one row per line. Blank lines are skipped and every row must have the same number of fields.
+	/// Throws <c>std::invalid_argument</c> naming the line of the first malformed field or row.
+	/// </summary>
+	template <typename T>
+	class HCsvGridParser {
+	private:
+		char m_delimiter;
+		std::size_t m_line = 0;
+		std::size_t m_columns = 0;
+		HGridBuilder<T> m_grid;
+
+		[[noreturn]] void fail(const char* what) const {
+			throw std::invalid_argument(std::string(what) + " on line " + std::to_string(m_line) + ".");
+		}
+
+	public:
+
+		explicit HCsvGridParser(char delimiter = ',') : m_delimiter(delimiter) {}
+
+		void operator()(std::string_view line) {
+			++m_line;
+			if (line.find_first_not_of(" \t") == std::string_view::npos)
+				return;
+
+			std::size_t start = 0;
+			while (true) {
+				const std::size_t stop = std::min(line.find(m_delimiter, start), line.size());
+				T value{};
+				if (!parseValue(line.substr(start, stop - start), value))
+					fail("Invalid CSV value");
+				m_grid.push(value);
+				if (stop == line.size())
+					break;
+				start = stop + 1;
+			}
+
+			// Every row must have exactly as many fields as the first one
+			const std::size_t length = m_grid.endRow();
+			if (m_grid.height() == 1)
+				m_columns = length;
+			else if (length != m_columns)
+				fail("Inconsistent number of CSV columns");
+		}
+
+		HMap<T> build(const hPoint& origin) const { return m_grid.build(origin, T{}); }
+
+	}; // class HCsvGridParser<T>
+
+	/// <summary>
+	/// Parse an ASCII grid held in memory, such as a string literal or a memory mapped file.
+	/// </summary>
+	/// <param name="table">Value of each character.</param>
+	/// <param name="origin">Top left corner of the resulting map.</param>
+	template <typename T>
+	inline HMap<T> parseAsciiGrid(std::string_view text, const hCharTable<T>& table, const hPoint& origin = { 0, 0 }) {
+		HAsciiGridParser<T> parser(table);
+		forEachLine(text, parser);
+		return parser.build(origin);
+	}
+
+	/// <summary>
+	/// Read an ASCII grid from a stream in blocks. See <see cref="parseAsciiGrid"/>.
+	/// </summary>
+	template <typename T>
+	inline HMap<T> readAsciiGrid(std::istream& input, const hCharTable<T>& table, const hPoint& origin = { 0, 0 }) {
+		HAsciiGridParser<T> parser(table);
+		forEachLine(input, parser);
+		return parser.build(origin);
+	}
+
+	/// <summary>
+	/// Parse a CSV grid of numbers held in memory, such as a string literal or a memory mapped file.
+	/// </summary>
+	/// <param name="origin">Top left corner of the resulting map.</param>
+	/// <param name="delimiter">Character separating the fields of a row.</param>
+	template <typename T>
+	inline HMap<T> parseCsvGrid(std::string_view text, const hPoint& origin = { 0, 0 }, char delimiter = ',') {
+		HCsvGridParser<T> parser(delimiter);
+		forEachLine(text, parser);
+		return parser.build(origin);
+	}
+
+	/// <summary>
+	/// Read a CSV grid of numbers from a stream in blocks. See <see cref="parseCsvGrid"/>.
+	/// </summary>
+	template <typename T>
+	inline HMap<T> readCsvGrid(std::istream& input, const hPoint& origin = { 0, 0 }, char delimiter = ',') {
+		HCsvGridParser<T> parser(delimiter);
+		forEachLine(input, parser);
+		return parser.build(origin);
+	}
+
+} // namespace hrzn
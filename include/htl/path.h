@@ -0,0 +1,407 @@
+/*
+MIT License
+
+Copyright (c) 2022 TheShouting
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "hrzn.h"
+
+#include <vector>
+#include <span>
+
+namespace hrzn {
+
+	/// <summary>
+	/// Per-agent state for walking along an <c>HPolyline</c>. Remembers the last segment so that sampling with
+	/// increasing distances only needs to step forward instead of searching.
+	/// </summary>
+	struct hPolylineCursor {
+		std::size_t segment = 0;
+	};
+
+
+	/// <summary>
+	/// A path of connected points which caches the cumulative length at every vertex, so positions can be looked
+	/// up by distance along the path without recomputing segment lengths.
+	/// </summary>
+	class HPolyline {
+	private:
+		std::vector<hVector> m_points;
+		std::vector<hType_f> m_lengths;
+		bool m_closed = false;
+
+	public:
+
+		HPolyline() {}
+
+		explicit HPolyline(std::span<const hVector> points, bool closed = false) { assign(points, closed); }
+
+		void assign(std::span<const hVector> points, bool closed = false) {
+			m_points.assign(points.begin(), points.end());
+			m_closed = closed;
+			update();
+		}
+
+		/// <summary>
+		/// Recompute the cached lengths after changing the points.
+		/// </summary>
+		void update() {
+			const std::size_t n = m_points.size();
+			const std::size_t segments = segmentCount();
+			m_lengths.resize(segments + 1);
+			if (n == 0)
+				return;
+			m_lengths[0] = 0._hf;
+			for (std::size_t i = 0; i < segments; ++i)
+				m_lengths[i + 1] = m_lengths[i] + static_cast<hType_f>((m_points[(i + 1) % n] - m_points[i]).length());
+		}
+
+		std::vector<hVector>& points() { return m_points; }
+		const std::vector<hVector>& points() const { return m_points; }
+
+		bool closed() const { return m_closed; }
+
+		std::size_t segmentCount() const {
+			const std::size_t n = m_points.size();
+			return n < 2 ? 0 : (m_closed ? n : n - 1);
+		}
+
+		hType_f length() const { return m_lengths.empty() ? 0._hf : m_lengths.back(); }
+
+		/// Distance along the path at vertex <paramref name="i"/>.
+		hType_f distanceAt(std::size_t i) const { return m_lengths[i]; }
+
+		/// <summary>
+		/// Wrap a distance onto a closed path, or clamp it to the ends of an open path.
+		/// </summary>
+		hType_f normalize(hType_f distance) const {
+			hType_f len = length();
+			if (m_closed && len > 0._hf) {
+				distance = std::fmod(distance, len);
+				return distance < 0._hf ? distance + len : distance;
+			}
+			return std::clamp(distance, 0._hf, len);
+		}
+
+		/// <summary>
+		/// Find the segment containing a distance using a binary search.
+		/// </summary>
+		std::size_t locate(hType_f distance) const {
+			const std::size_t segments = segmentCount();
+			if (segments == 0)
+				return 0;
+			auto it = std::upper_bound(m_lengths.begin(), m_lengths.end(), distance);
+			std::size_t i = static_cast<std::size_t>(it - m_lengths.begin());
+			return std::min(i > 0 ? i - 1 : 0, segments - 1);
+		}
+
+		/// <summary>
+		/// Find the segment containing a distance, starting from the segment cached in the cursor.
+		/// </summary>
+		std::size_t locate(hType_f distance, hPolylineCursor& cursor) const {
+			const std::size_t segments = segmentCount();
+			std::size_t k = cursor.segment;
+			if (k < segments && distance >= m_lengths[k]) {
+				// Walk forward a few segments before giving up on the cache.
+				for (int step = 0; step < 4 && k < segments; ++step, ++k)
+					if (distance < m_lengths[k + 1] || k + 1 == segments)
+						return cursor.segment = k;
+			}
+			return cursor.segment = locate(distance);
+		}
+
+		hVector interpolate(std::size_t segment, hType_f distance) const {
+			const std::size_t n = m_points.size();
+			const hVector a = m_points[segment];
+			const hVector b = m_points[(segment + 1) % n];
+			const hType_f len = m_lengths[segment + 1] - m_lengths[segment];
+			const hType_f t = len > 0._hf ? (distance - m_lengths[segment]) / len : 0._hf;
+			return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+		}
+
+		/// <summary>
+		/// Find the position at a distance along the path in O(log n).
+		/// </summary>
+		hVector at(hType_f distance) const {
+			if (segmentCount() == 0)
+				return m_points.empty() ? hVector() : m_points[0];
+			distance = normalize(distance);
+			return interpolate(locate(distance), distance);
+		}
+
+		/// <summary>
+		/// Find the position at a distance along the path. Amortized O(1) when the distance increases between calls.
+		/// </summary>
+		hVector at(hType_f distance, hPolylineCursor& cursor) const {
+			if (segmentCount() == 0)
+				return m_points.empty() ? hVector() : m_points[0];
+			distance = normalize(distance);
+			return interpolate(locate(distance, cursor), distance);
+		}
+
+		/// <summary>
+		/// Get the unit direction of the path at a distance.
+		/// </summary>
+		hVector tangent(hType_f distance) const {
+			if (segmentCount() == 0)
+				return hVector();
+			std::size_t i = locate(normalize(distance));
+			return (m_points[(i + 1) % m_points.size()] - m_points[i]).normal();
+		}
+
+		/// <summary>
+		/// Sample the positions of many agents, each with its own distance and cursor.
+		/// </summary>
+		void sample(std::span<const hType_f> distances, std::span<hPolylineCursor> cursors, std::span<hVector> out) const {
+			assert(cursors.size() >= distances.size() && out.size() >= distances.size());
+			for (std::size_t i = 0; i < distances.size(); ++i)
+				out[i] = at(distances[i], cursors[i]);
+		}
+
+		/// <summary>
+		/// Place points at equal distances along the path. Both ends of an open path are included.
+		/// </summary>
+		/// <param name="spacing">Distance between consecutive points.</param>
+		/// <param name="out">Cleared and filled with the resampled points.</param>
+		void resample(hType_f spacing, std::vector<hVector>& out) const {
+			out.clear();
+			if (segmentCount() == 0 || spacing <= 0._hf) {
+				out.assign(m_points.begin(), m_points.end());
+				return;
+			}
+			const hType_f len = length();
+			const std::size_t count = static_cast<std::size_t>(len / spacing);
+			out.reserve(count + 2);
+			hPolylineCursor cursor;
+			for (std::size_t i = 0; i <= count; ++i) {
+				hType_f d = spacing * static_cast<hType_f>(i);
+				if (m_closed && d >= len)
+					break;
+				out.push_back(interpolate(locate(d, cursor), d));
+			}
+			if (!m_closed && len - spacing * static_cast<hType_f>(count) > H_EPSILON)
+				out.push_back(m_points.back());
+		}
+
+	}; // class HPolyline
+
+
+	/// <summary>
+	/// A piecewise cubic curve. Every segment is stored as polynomial coefficients, so evaluating a point costs a
+	/// few multiply-adds whichever kind of spline it was built from. Parameter <c>u</c> runs from 0 to
+	/// <c>segmentCount()</c>, with the integer part selecting the segment.
+	/// </summary>
+	class HSpline {
+	private:
+		// Four coefficients per segment: p(t) = a + b*t + c*t^2 + d*t^3.
+		std::vector<hVector> m_coeffs;
+
+		void addSegment(hVector a, hVector b, hVector c, hVector d) {
+			m_coeffs.push_back(a);
+			m_coeffs.push_back(b);
+			m_coeffs.push_back(c);
+			m_coeffs.push_back(d);
+		}
+
+		/// Add a segment from its end points and end tangents.
+		void addHermite(hVector p1, hVector p2, hVector m1, hVector m2) {
+			addSegment(p1, m1, p1 * -3._hf + p2 * 3._hf - m1 * 2._hf - m2, p1 * 2._hf - p2 * 2._hf + m1 + m2);
+		}
+
+		/// Split a parameter into a segment index and local parameter.
+		std::size_t segmentOf(hType_f u, hType_f& t) const {
+			const std::size_t n = segmentCount();
+			if (u <= 0._hf) {
+				t = 0._hf;
+				return 0;
+			}
+			std::size_t i = static_cast<std::size_t>(u);
+			if (i >= n) {
+				t = 1._hf;
+				return n - 1;
+			}
+			t = u - static_cast<hType_f>(i);
+			return i;
+		}
+
+	public:
+
+		HSpline() {}
+
+		std::size_t segmentCount() const { return m_coeffs.size() / 4; }
+
+		void clear() { m_coeffs.clear(); }
+
+		/// <summary>
+		/// Build a Catmull-Rom spline passing through every control point.
+		/// </summary>
+		/// <param name="alpha">Knot parameterization: 0 for uniform, 0.5 for centripetal, 1 for chordal.</param>
+		static HSpline CatmullRom(std::span<const hVector> points, bool closed = false, hType_f alpha = 0.5_hf) {
+			HSpline spline;
+			const std::size_t n = points.size();
+			if (n < 2)
+				return spline;
+			auto at = [&](std::ptrdiff_t i) -> hVector {
+				if (closed)
+					return points[static_cast<std::size_t>((i % static_cast<std::ptrdiff_t>(n) + n) % n)];
+				if (i < 0)
+					return points[0] * 2._hf - points[1];
+				if (i >= static_cast<std::ptrdiff_t>(n))
+					return points[n - 1] * 2._hf - points[n - 2];
+				return points[static_cast<std::size_t>(i)];
+			};
+			auto knot = [alpha](hVector a, hVector b) {
+				return std::max(static_cast<hType_f>(std::pow((b - a).lengthSqr(), alpha * 0.5_hf)), H_EPSILON);
+			};
+
+			const std::size_t segments = closed ? n : n - 1;
+			spline.m_coeffs.reserve(segments * 4);
+			for (std::size_t s = 0; s < segments; ++s) {
+				std::ptrdiff_t i = static_cast<std::ptrdiff_t>(s);
+				hVector p0 = at(i - 1), p1 = at(i), p2 = at(i + 1), p3 = at(i + 2);
+				hType_f d01 = knot(p0, p1), d12 = knot(p1, p2), d23 = knot(p2, p3);
+				hVector m1 = ((p1 - p0) / d01 - (p2 - p0) / (d01 + d12) + (p2 - p1) / d12) * d12;
+				hVector m2 = ((p2 - p1) / d12 - (p3 - p1) / (d12 + d23) + (p3 - p2) / d23) * d12;
+				spline.addHermite(p1, p2, m1, m2);
+			}
+			return spline;
+		}
+
+		/// <summary>
+		/// Build a chain of cubic Bezier curves. Consecutive curves share an end point, so 3n + 1 control points make n segments.
+		/// </summary>
+		static HSpline Bezier(std::span<const hVector> points) {
+			HSpline spline;
+			for (std::size_t i = 0; i + 3 < points.size(); i += 3) {
+				hVector p0 = points[i], p1 = points[i + 1], p2 = points[i + 2], p3 = points[i + 3];
+				spline.addSegment(p0, (p1 - p0) * 3._hf, (p0 - p1 * 2._hf + p2) * 3._hf, -p0 + p1 * 3._hf - p2 * 3._hf + p3);
+			}
+			return spline;
+		}
+
+		/// <summary>
+		/// Build a uniform cubic B-spline. The curve approximates the control points without passing through them.
+		/// </summary>
+		static HSpline BSpline(std::span<const hVector> points, bool closed = false) {
+			HSpline spline;
+			const std::size_t n = points.size();
+			if (n < (closed ? 3u : 4u))
+				return spline;
+			const std::size_t segments = closed ? n : n - 3;
+			const hType_f sixth = 1._hf / 6._hf;
+			for (std::size_t s = 0; s < segments; ++s) {
+				hVector p0 = points[s % n], p1 = points[(s + 1) % n], p2 = points[(s + 2) % n], p3 = points[(s + 3) % n];
+				spline.addSegment((p0 + p1 * 4._hf + p2) * sixth, (p2 - p0) * (3._hf * sixth),
+					(p0 - p1 * 2._hf + p2) * (3._hf * sixth), (-p0 + p1 * 3._hf - p2 * 3._hf + p3) * sixth);
+			}
+			return spline;
+		}
+
+		hVector at(hType_f u) const {
+			if (m_coeffs.empty())
+				return hVector();
+			hType_f t;
+			const hVector* c = &m_coeffs[segmentOf(u, t) * 4];
+			return { c[0].x + t * (c[1].x + t * (c[2].x + t * c[3].x)), c[0].y + t * (c[1].y + t * (c[2].y + t * c[3].y)) };
+		}
+
+		/// Get the first derivative with respect to <c>u</c>.
+		hVector derivative(hType_f u) const {
+			if (m_coeffs.empty())
+				return hVector();
+			hType_f t;
+			const hVector* c = &m_coeffs[segmentOf(u, t) * 4];
+			return { c[1].x + t * (2._hf * c[2].x + t * 3._hf * c[3].x), c[1].y + t * (2._hf * c[2].y + t * 3._hf * c[3].y) };
+		}
+
+		/// <summary>
+		/// Evaluate the curve at many parameters.
+		/// </summary>
+		void evaluate(std::span<const hType_f> u, std::span<hVector> out) const {
+			assert(out.size() >= u.size());
+			if (m_coeffs.empty())
+				return;
+			const hVector* coeffs = m_coeffs.data();
+			for (std::size_t i = 0; i < u.size(); ++i) {
+				hType_f t;
+				const hVector* c = coeffs + segmentOf(u[i], t) * 4;
+				out[i].x = c[0].x + t * (c[1].x + t * (c[2].x + t * c[3].x));
+				out[i].y = c[0].y + t * (c[1].y + t * (c[2].y + t * c[3].y));
+			}
+		}
+
+		/// <summary>
+		/// Convert the curve into a polyline. Each piece is subdivided until its Bezier control points lie within
+		/// <paramref name="tolerance"/> of the chord, which bounds the distance between the curve and the polyline.
+		/// </summary>
+		/// <param name="out">Cleared and filled with the polyline vertices.</param>
+		void flatten(hType_f tolerance, std::vector<hVector>& out) const {
+			out.clear();
+			const std::size_t n = segmentCount();
+			if (n == 0)
+				return;
+			const hType_f tol_sqr = tolerance * tolerance;
+			constexpr int max_depth = 16;
+			std::pair<hType_f, int> stack[max_depth + 2];
+
+			out.push_back(at(0._hf));
+			for (std::size_t s = 0; s < n; ++s) {
+				const hVector* c = &m_coeffs[s * 4];
+				auto point = [c](hType_f t) { return c[0] + (c[1] + (c[2] + c[3] * t) * t) * t; };
+				auto slope = [c](hType_f t) { return c[1] + (c[2] * 2._hf + c[3] * (3._hf * t)) * t; };
+
+				// Each stack entry holds the end of a pending range and its depth; ranges are consumed left to right.
+				hType_f t0 = 0._hf;
+				int top = 0;
+				stack[top++] = { 1._hf, 0 };
+				while (top > 0) {
+					auto [t1, depth] = stack[top - 1];
+					hType_f h = t1 - t0;
+					hVector p0 = point(t0);
+					hVector p3 = point(t1);
+					hVector p1 = p0 + slope(t0) * (h / 3._hf);
+					hVector p2 = p3 - slope(t1) * (h / 3._hf);
+
+					hVector chord = p3 - p0;
+					hType_f len_sqr = chord.lengthSqr();
+					auto dist_sqr = [&](hVector p) {
+						hVector d = p - p0;
+						hType_f f = len_sqr > 0._hf ? std::clamp((d.x * chord.x + d.y * chord.y) / len_sqr, 0._hf, 1._hf) : 0._hf;
+						return (d - chord * f).lengthSqr();
+					};
+					bool flat = dist_sqr(p1) <= tol_sqr && dist_sqr(p2) <= tol_sqr;
+					if (flat || depth >= max_depth) {
+						out.push_back(p3);
+						t0 = t1;
+						--top;
+					}
+					else {
+						stack[top - 1].second = depth + 1;
+						stack[top++] = { t0 + h * 0.5_hf, depth + 1 };
+					}
+				}
+			}
+		}
+
+	}; // class HSpline
+
+} // namespace hrzn
@@ -27,6 +27,11 @@ SOFTWARE.
 
 #include <sstream>
 #include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <type_traits>
 
 namespace hrzn {
 
@@ -135,6 +140,19 @@ namespace hrzn {
 	}
 
 
+	/// <summary>
+	/// Append a horizontal line of arbitrary size to a string. See <see cref="makeStringLine"/>.
+	/// </summary>
+	inline void appendStringLine(std::string& out, int length, char symbol, char first, char last) {
+		if (first) {
+			length--;
+			out.push_back(first);
+		}
+		if (length > 1)
+			out.append(length - 1, symbol);
+		out.push_back(last ? last : symbol);
+	}
+
 	/// <summary>
 	/// Create a formatted string of arbitrary size to be used as a horizontal line.
 	/// </summary>
@@ -144,104 +162,223 @@ namespace hrzn {
 	/// <param name="last">Character to last the line with.</param>
 	/// <returns>A string of the formatted line.</returns>
 	inline std::string makeStringLine(int length, char symbol, char first, char last) {
-		std::stringstream ss;
-		if (first) {
-			length--;
-			ss << first;
+		std::string line;
+		appendStringLine(line, length, symbol, first, last);
+		return line;
+	}
+
+	/// <summary>
+	/// Append <paramref name="text"/> right aligned in a field of at least <paramref name="width"/> characters, as <c>std::setw</c> would.
+	/// </summary>
+	inline void appendField(std::string& out, std::string_view text, unsigned int width) {
+		if (text.size() < width)
+			out.append(width - text.size(), ' ');
+		out.append(text);
+	}
+
+	/// <summary>
+	/// Append a value right aligned in a field of at least <paramref name="width"/> characters. Arithmetic types are written
+	/// with <c>std::to_chars</c> and produce the same text as a stream set to fixed notation with <paramref name="precision"/>
+	/// digits. Any other type is formatted through its stream operator.
+	/// </summary>
+	template <typename T>
+	inline void appendValue(std::string& out, const T& value, unsigned int width, int precision) {
+		if constexpr (std::is_same_v<T, bool>) {
+			appendField(out, value ? "1" : "0", width);
 		}
-		for (int i = 0; i < length-1; i++) {
-			ss << symbol;
+		else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+			const char c = static_cast<char>(value);
+			appendField(out, std::string_view(&c, 1), width);
 		}
-		if (last) {
-			ss << last;
+		else if constexpr (std::is_integral_v<T>) {
+			char buf[32];
+			auto res = std::to_chars(buf, buf + sizeof(buf), value);
+			appendField(out, std::string_view(buf, res.ptr - buf), width);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			char buf[128];
+			auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, precision);
+			if (res.ec == std::errc()) {
+				appendField(out, std::string_view(buf, res.ptr - buf), width);
+				return;
+			}
+			std::ostringstream ss;
+			ss.precision(precision);
+			ss.setf(std::ios::fixed);
+			ss << value;
+			appendField(out, ss.str(), width);
 		}
 		else {
-			ss << symbol;
+			std::ostringstream ss;
+			ss.precision(precision);
+			ss.setf(std::ios::fixed);
+			ss << value;
+			appendField(out, ss.str(), width);
 		}
-		return ss.str();
 	}
 
 	/// <summary>
-	/// Convert a Matrix of values to a formatted table in a string.
+	/// Append the escape sequence selecting colour <paramref name="color"/> of the 256 colour ANSI palette.
+	/// A negative value resets to the default colour.
 	/// </summary>
-	/// <typeparam name="T"></typeparam>
-	/// <returns>A string containing the formatted table ready for printing or writing.</returns>
-	template <typename T>
-	inline std::string toStringTable(const IMap<T>& mat, const hStringTableStyle & style = hStringTableStyle())
-	{
-		std::stringstream ss;
-		ss.precision(style.precision);
-		ss.setf(std::ios::fixed);
+	inline void appendAnsiColor(std::string& out, int color) {
+		if (color < 0) {
+			out.append("\x1b[0m");
+			return;
+		}
+		char buf[4];
+		auto res = std::to_chars(buf, buf + sizeof(buf), color & 0xff);
+		out.append("\x1b[38;5;");
+		out.append(buf, res.ptr);
+		out.push_back('m');
+	}
 
-		int rail_pad = (int)(style.siding != 0);
+	/// <summary>
+	/// Render the frame of a table over <paramref name="area"/> and call <paramref name="cells"/> to append each row's cells.
+	/// The output is built in one buffer reserved up front. When <paramref name="stream"/> is given, the buffer is written to it
+	/// and reused every few rows, so memory stays bounded for very large maps.
+	/// </summary>
+	template <typename TCells>
+	inline void renderStringTable(std::string& out, std::ostream* stream, const hArea& area, const hStringTableStyle& style, TCells cells) {
+		constexpr std::size_t chunk = 1 << 16;
+		const int rail_pad = (int)(style.siding != 0);
+		const int line_length = (int)((area.width() + style.enumerate + 1) * style.padding + rail_pad);
+		const std::size_t row_length = (std::size_t)line_length + 1;
+
+		out.reserve(stream ? std::min<std::size_t>(chunk + row_length, row_length * (area.height() + 3)) : row_length * (area.height() + 3));
+
+		auto flush = [&](bool force) {
+			if (stream && (force || out.size() >= chunk)) {
+				stream->write(out.data(), (std::streamsize)out.size());
+				out.clear();
+			}
+		};
+		auto rail = [&]() {
+			if (style.padding > 1)
+				out.append(style.padding - 1, ' ');
+			if (style.siding)
+				out.push_back(style.siding);
+			out.push_back('\n');
+		};
 
 		// Top table border
-		if (style.top_line)
-			ss << makeStringLine((mat.width() + style.enumerate + 1) * style.padding + rail_pad, style.top_line, style.corner, style.corner) << '\n';
+		if (style.top_line) {
+			appendStringLine(out, line_length, style.top_line, style.corner, style.corner);
+			out.push_back('\n');
+		}
 
 		// Column numbering
 		if (style.enumerate) {
-			ss << style.siding << std::setw(style.padding) << "";
-			for (int x = mat.x1; x < mat.x2; x++)
-				ss << std::setw(style.padding) << x;
-			ss << std::setw(style.padding) << style.siding << '\n';
+			if (style.siding)
+				out.push_back(style.siding);
+			out.append(style.padding, ' ');
+			for (hType_i x = area.x1; x < area.x2; x++)
+				appendValue(out, x, style.padding, style.precision);
+			rail();
 		}
 
 		// Map content
-		for (int y = mat.y1; y < mat.y2; y++) {
-			ss << style.siding;
-			if (style.enumerate) {
-				ss << std::setw(style.padding) << y;
-			}
-			for (int x = mat.x1; x < mat.x2; x++)
-				ss << std::setw(style.padding) << mat.at(x, y);
-			ss << std::setw(style.padding) << style.siding << '\n';
+		for (hType_i y = area.y1; y < area.y2; y++) {
+			if (style.siding)
+				out.push_back(style.siding);
+			if (style.enumerate)
+				appendValue(out, y, style.padding, style.precision);
+			cells(out, y);
+			rail();
+			flush(false);
 		}
 
 		// Bottom table border
-		if (style.bottom_line)
-			ss << makeStringLine((mat.width() + style.enumerate + 1) * style.padding + rail_pad, style.bottom_line, style.corner, style.corner) << '\n';
+		if (style.bottom_line) {
+			appendStringLine(out, line_length, style.bottom_line, style.corner, style.corner);
+			out.push_back('\n');
+		}
+		flush(true);
+	}
 
-		return ss.str();
+	/// <summary>
+	/// Append one row of a map to a table, reading it through the map's row pointer when it has one.
+	/// </summary>
+	/// <param name="format">Called as <c>format(out, value)</c> to append a single cell.</param>
+	/// <param name="color">Callable returning the palette colour of a value, or <c>nullptr</c> for no colour.</param>
+	template <typename T, typename TFormat, typename TColor>
+	inline void appendTableRow(std::string& out, const IMap<T>& mat, hType_i y, TFormat& format, TColor& color) {
+		const T* row = mat.row(y);
+		[[maybe_unused]] int current = -1;
+		for (hType_i x = mat.x1; x < mat.x2; x++) {
+			const T value = row ? row[x - mat.x1] : mat.at(x, y);
+			if constexpr (!std::is_null_pointer_v<TColor>) {
+				const int c = color(value);
+				if (c != current) {
+					appendAnsiColor(out, c);
+					current = c;
+				}
+			}
+			format(out, value);
+		}
+		if constexpr (!std::is_null_pointer_v<TColor>) {
+			if (current >= 0)
+				appendAnsiColor(out, -1);
+		}
 	}
 
 	/// <summary>
-	/// Convert a Mask of boolean values to a formatted table in a string.
+	/// Convert a Matrix of values to a formatted table in a string.
 	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	/// <param name="color">Optional callable returning the 256 colour ANSI palette index for a value, or a negative number for the default colour.</param>
 	/// <returns>A string containing the formatted table ready for printing or writing.</returns>
-	/// <returns></returns>
-	inline std::string toStringMask(const IMap<bool>& mat, const hStringTableStyle & style = hStringTableStyle())
+	template <typename T, typename TColor = std::nullptr_t>
+	inline std::string toStringTable(const IMap<T>& mat, const hStringTableStyle & style = hStringTableStyle(), TColor color = nullptr)
 	{
+		std::string out;
+		auto format = [&style](std::string& o, const T& v) { appendValue(o, v, style.padding, style.precision); };
+		renderStringTable(out, nullptr, mat, style, [&](std::string& o, hType_i y) { appendTableRow(o, mat, y, format, color); });
+		return out;
+	}
 
-		std::stringstream ss;
-
-		int rail_pad = (int)(style.siding != 0);
-
-
-		if (style.top_line)
-			ss << makeStringLine((mat.width() + style.enumerate + 1) * style.padding + rail_pad, style.top_line, style.corner, style.corner) << '\n';
-
-		if (style.enumerate) {
-			ss << style.siding << std::setw(style.padding) << "";
-			for (int x = mat.x1; x < mat.x2; x++)
-				ss << std::setw(style.padding) << x;
-			ss << std::setw(style.padding) << style.siding << '\n';
-		}
-
-		for (int y = mat.y1; y < mat.y2; y++) {
-			ss << style.siding;
-			if (style.enumerate) {
-				ss << std::setw(style.padding) << y;
-			}
-			for (int x = mat.x1; x < mat.x2; x++)
-				ss << std::setw(style.padding) << (mat.at(x, y) ? style.filled : style.empty);
-			ss << std::setw(style.padding) << style.siding << '\n';
-		}
+	/// <summary>
+	/// Write a Matrix of values as a formatted table to a stream in chunks of rows. See <see cref="toStringTable"/>.
+	/// </summary>
+	template <typename T, typename TColor = std::nullptr_t>
+	inline std::ostream& writeStringTable(std::ostream& output, const IMap<T>& mat, const hStringTableStyle & style = hStringTableStyle(), TColor color = nullptr)
+	{
+		std::string out;
+		auto format = [&style](std::string& o, const T& v) { appendValue(o, v, style.padding, style.precision); };
+		renderStringTable(out, &output, mat, style, [&](std::string& o, hType_i y) { appendTableRow(o, mat, y, format, color); });
+		return output;
+	}
 
-		if (style.bottom_line)
-			ss << makeStringLine((mat.width() + style.enumerate + 1) * style.padding + rail_pad, style.bottom_line, style.corner, style.corner) << '\n';
+	/// <summary>
+	/// Convert a Mask of boolean values to a formatted table in a string.
+	/// </summary>
+	/// <param name="color">Optional callable returning the 256 colour ANSI palette index for a value, or a negative number for the default colour.</param>
+	/// <returns>A string containing the formatted table ready for printing or writing.</returns>
+	template <typename TColor = std::nullptr_t>
+	inline std::string toStringMask(const IMap<bool>& mat, const hStringTableStyle & style = hStringTableStyle(), TColor color = nullptr)
+	{
+		std::string out;
+		auto format = [&style](std::string& o, bool v) {
+			const char c = v ? style.filled : style.empty;
+			appendField(o, std::string_view(&c, 1), style.padding);
+		};
+		renderStringTable(out, nullptr, mat, style, [&](std::string& o, hType_i y) { appendTableRow(o, mat, y, format, color); });
+		return out;
+	}
 
-		return ss.str();
+	/// <summary>
+	/// Write a Mask of boolean values as a formatted table to a stream in chunks of rows. See <see cref="toStringMask"/>.
+	/// </summary>
+	template <typename TColor = std::nullptr_t>
+	inline std::ostream& writeStringMask(std::ostream& output, const IMap<bool>& mat, const hStringTableStyle & style = hStringTableStyle(), TColor color = nullptr)
+	{
+		std::string out;
+		auto format = [&style](std::string& o, bool v) {
+			const char c = v ? style.filled : style.empty;
+			appendField(o, std::string_view(&c, 1), style.padding);
+		};
+		renderStringTable(out, &output, mat, style, [&](std::string& o, hType_i y) { appendTableRow(o, mat, y, format, color); });
+		return output;
 	}
 
-} // namespace hrzn
\ No newline at end of file
+} // namespace hrzn
@@ -26,6 +26,17 @@ SOFTWARE.
 #include "hrzn.h"
 
 #include <vector>
+#include <span>
+#include <thread>
+#include <system_error>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+/// Point counts at or above this are reduced on multiple threads by the span overloads of boundingBox and makeAreaBoundary.
+#ifndef H_PARALLEL_THRESHOLD
+#define H_PARALLEL_THRESHOLD (1u << 20)
+#endif
 
 namespace hrzn {
 
@@ -33,19 +44,19 @@ namespace hrzn {
 		Transform Operations
 	******************************************************************************************************************/
 
-	inline hPoint clampPoint(const hPoint& p, const hArea& area) {
+	constexpr hPoint clampPoint(const hPoint& p, const hArea& area) {
 		hType_i x = std::min(std::max(p.x, area.x1), area.x2 - 1_hi);
 		hType_i y = std::min(std::max(p.y, area.y1), area.y2 - 1_hi);
 		return { x, y };
 	}
 
-	inline hPoint wrapPoint(const hPoint& p, const hArea& area) {
+	constexpr hPoint wrapPoint(const hPoint& p, const hArea& area) {
 		hType_i x = (p.x % area.width() + area.width()) % area.width();
 		hType_i y = (p.y % area.height() + area.height()) % area.height();
 		return { x, y };
 	}
 
-	inline hType_f dotProduct(const hVector& a, const hVector& b) {
+	constexpr hType_f dotProduct(const hVector& a, const hVector& b) {
 		return a.x * b.x + a.y * b.y;
 	}
 
@@ -53,7 +64,7 @@ namespace hrzn {
 		return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
 	}
 
-	inline hType_f distanceSqr(const hVector& a, const hVector& b) {
+	constexpr hType_f distanceSqr(const hVector& a, const hVector& b) {
 		return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
 	}
 
@@ -79,50 +90,466 @@ namespace hrzn {
 	}
 
 
+	/******************************************************************************************************************
+		Batch Vector Operations
+	******************************************************************************************************************/
+
+	/// <summary>
+	/// Selects between the exact standard library math and cheaper approximations in the batch kernels.
+	/// Each kernel documents the error bound of its <c>Fast</c> and <c>Coarse</c> paths.
+	/// </summary>
+	enum class hAccuracy {
+		Exact,
+		Fast,
+		Coarse
+	};
+
+	/// <summary>
+	/// A list of vectors stored as separate x and y arrays, so that batch kernels can stream each component.
+	/// </summary>
+	struct hVectorBatch {
+		std::vector<hType_f> x, y;
+
+		hVectorBatch() {}
+		explicit hVectorBatch(std::size_t n) { resize(n); }
+		explicit hVectorBatch(std::span<const hVector> vectors) { assign(vectors); }
+
+		std::size_t size() const { return x.size(); }
+
+		void resize(std::size_t n) {
+			x.resize(n, 0._hf);
+			y.resize(n, 0._hf);
+		}
+
+		void assign(std::span<const hVector> vectors) {
+			resize(vectors.size());
+			for (std::size_t i = 0; i < vectors.size(); ++i) {
+				x[i] = vectors[i].x;
+				y[i] = vectors[i].y;
+			}
+		}
+
+		hVector get(std::size_t i) const { return { x[i], y[i] }; }
+
+		void set(std::size_t i, const hVector& v) {
+			x[i] = v.x;
+			y[i] = v.y;
+		}
+
+		void push_back(const hVector& v) {
+			x.push_back(v.x);
+			y.push_back(v.y);
+		}
+
+	}; // struct hVectorBatch
+
+
+	/// <summary>
+	/// Narrow a list of points to 16 bit coordinates. The loop is branch free so it vectorizes; range failures are collected
+	/// and reported once at the end.
+	/// </summary>
+	/// <returns>False if any component was out of range, in which case the affected entries of <paramref name="out"/> are wrapped.</returns>
+	inline bool narrowPoints(std::span<const hPoint> in, std::span<hPoint16> out) {
+		assert(out.size() >= in.size());
+		constexpr hType_i lo = std::numeric_limits<std::int16_t>::lowest();
+		constexpr hType_i hi = std::numeric_limits<std::int16_t>::max();
+		bool ok = true;
+		for (std::size_t i = 0; i < in.size(); ++i) {
+			const hType_i x = in[i].x;
+			const hType_i y = in[i].y;
+			ok &= (x >= lo) & (x <= hi) & (y >= lo) & (y <= hi);
+			out[i].x = static_cast<std::int16_t>(x);
+			out[i].y = static_cast<std::int16_t>(y);
+		}
+		return ok;
+	}
+
+	inline void widenPoints(std::span<const hPoint16> in, std::span<hPoint> out) {
+		assert(out.size() >= in.size());
+		for (std::size_t i = 0; i < in.size(); ++i) {
+			out[i].x = in[i].x;
+			out[i].y = in[i].y;
+		}
+	}
+
+	/// Write the <see cref="packKey"/> of every point, e.g. to sort points in map order or to bucket them in a spatial hash.
+	inline void packKeys(std::span<const hPoint16> points, std::span<std::uint32_t> keys) {
+		assert(keys.size() >= points.size());
+		for (std::size_t i = 0; i < points.size(); ++i)
+			keys[i] = packKey(points[i]);
+	}
+
+	/// <summary>
+	/// Approximate 1/sqrt(v) from the exponent bit trick followed by <paramref name="steps"/> Newton-Raphson refinements.
+	/// One step gives a relative error below 2e-3, two below 1e-5 and three below 1e-10 (double precision only).
+	/// </summary>
+	template <typename T>
+	inline T fastInverseSqrt(T v, int steps = sizeof(T) == sizeof(std::uint32_t) ? 2 : 3) {
+		static_assert(sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t));
+		T r;
+		if constexpr (sizeof(T) == sizeof(std::uint32_t))
+			r = std::bit_cast<T>(std::uint32_t(0x5f3759df) - (std::bit_cast<std::uint32_t>(v) >> 1));
+		else
+			r = std::bit_cast<T>(std::uint64_t(0x5fe6eb50c7b537a9) - (std::bit_cast<std::uint64_t>(v) >> 1));
+		const T half = T(0.5) * v;
+		for (int i = 0; i < steps; ++i)
+			r = r * (T(1.5) - half * r * r);
+		return r;
+	}
+
+	/// Write the length of every vector in <paramref name="xs"/>, <paramref name="ys"/> to <paramref name="out"/>.
+	inline void lengths(std::span<const hType_f> xs, std::span<const hType_f> ys, std::span<hType_f> out) {
+		assert(ys.size() >= xs.size() && out.size() >= xs.size());
+		const hType_f* px = xs.data();
+		const hType_f* py = ys.data();
+		hType_f* po = out.data();
+		const std::size_t n = xs.size();
+		for (std::size_t i = 0; i < n; ++i)
+			po[i] = std::sqrt(px[i] * px[i] + py[i] * py[i]);
+	}
+
+	inline void lengths(const hVectorBatch& vectors, std::span<hType_f> out) {
+		lengths(vectors.x, vectors.y, out);
+	}
+
+	inline void lengths(std::span<const hVector> vectors, std::span<hType_f> out) {
+		assert(out.size() >= vectors.size());
+		for (std::size_t i = 0; i < vectors.size(); ++i)
+			out[i] = std::sqrt(vectors[i].x * vectors[i].x + vectors[i].y * vectors[i].y);
+	}
+
+	/// <summary>
+	/// Normalize every vector in place. As with <see cref="getNormalized"/>, vectors shorter than H_EPSILON become zero.
+	/// <c>hAccuracy::Fast</c> replaces the square root and division with <see cref="fastInverseSqrt"/>,
+	/// and <c>hAccuracy::Coarse</c> does the same with a single refinement step.
+	/// </summary>
+	inline void normalize(std::span<hType_f> xs, std::span<hType_f> ys, hAccuracy accuracy = hAccuracy::Exact) {
+		assert(ys.size() >= xs.size());
+		hType_f* px = xs.data();
+		hType_f* py = ys.data();
+		const std::size_t n = xs.size();
+		constexpr hType_f eps_sqr = H_EPSILON * H_EPSILON;
+		if (accuracy != hAccuracy::Exact) {
+			const int steps = accuracy == hAccuracy::Coarse ? 1 : sizeof(hType_f) == sizeof(std::uint32_t) ? 2 : 3;
+			for (std::size_t i = 0; i < n; ++i) {
+				const hType_f l2 = px[i] * px[i] + py[i] * py[i];
+				const hType_f il = l2 < eps_sqr ? 0._hf : fastInverseSqrt(l2, steps);
+				px[i] *= il;
+				py[i] *= il;
+			}
+		}
+		else {
+			for (std::size_t i = 0; i < n; ++i) {
+				const hType_f l2 = px[i] * px[i] + py[i] * py[i];
+				const hType_f il = l2 < eps_sqr ? 0._hf : 1._hf / std::sqrt(l2);
+				px[i] *= il;
+				py[i] *= il;
+			}
+		}
+	}
+
+	inline void normalize(hVectorBatch& vectors, hAccuracy accuracy = hAccuracy::Exact) {
+		normalize(vectors.x, vectors.y, accuracy);
+	}
+
+	inline void normalize(std::span<hVector> vectors, hAccuracy accuracy = hAccuracy::Exact) {
+		constexpr hType_f eps_sqr = H_EPSILON * H_EPSILON;
+		const int steps = accuracy == hAccuracy::Coarse ? 1 : sizeof(hType_f) == sizeof(std::uint32_t) ? 2 : 3;
+		for (hVector& v : vectors) {
+			const hType_f l2 = v.x * v.x + v.y * v.y;
+			const hType_f il = l2 < eps_sqr ? 0._hf : accuracy != hAccuracy::Exact ? fastInverseSqrt(l2, steps) : 1._hf / std::sqrt(l2);
+			v.x *= il;
+			v.y *= il;
+		}
+	}
+
+	/// <summary>
+	/// The angle of the vector (x, y) in turns, wrapped to [0, 1) like <see cref="hRotation::setWithVector"/>.
+	/// The argument is reduced to the first octant and atan evaluated there by a minimax polynomial:
+	/// <c>hAccuracy::Fast</c> uses an 11th-order polynomial with a maximum error of 3e-7 turns (1.8e-6 radians),
+	/// <c>hAccuracy::Coarse</c> a quadratic with a maximum error of 6e-4 turns (0.22 degrees). Float rounding adds up to 1e-7 turns.
+	/// A zero vector has an angle of 0.
+	/// </summary>
+	template <hAccuracy A>
+	inline hType_f atan2Turns(hType_f y, hType_f x) {
+		if constexpr (A == hAccuracy::Exact) {
+			const hType_f t = std::atan2(y, x) / H_RAD;
+			return t - std::floor(t);
+		}
+		else {
+			const hType_f ax = std::abs(x);
+			const hType_f ay = std::abs(y);
+			const hType_f mx = std::max(ax, ay);
+			const hType_f mn = std::min(ax, ay);
+			const hType_f a = mx > 0._hf ? mn / mx : 0._hf;
+			hType_f t;
+			if constexpr (A == hAccuracy::Fast) {
+				const hType_f s = a * a;
+				t = a * (0.99997726_hf + s * (-0.33262347_hf + s * (0.19354346_hf + s * (-0.11643287_hf + s * (0.05265332_hf + s * -0.01172120_hf))))) / H_RAD;
+			}
+			else {
+				t = (0.125_hf + 0.0434493_hf * (1._hf - a)) * a;
+			}
+			t = ay > ax ? 0.25_hf - t : t;
+			t = x < 0._hf ? 0.5_hf - t : t;
+			t = y < 0._hf ? 1._hf - t : t;
+			return t < 1._hf ? t : 0._hf;
+		}
+	}
+
+	inline hType_f atan2Turns(hType_f y, hType_f x, hAccuracy accuracy = hAccuracy::Exact) {
+		switch (accuracy) {
+		case hAccuracy::Fast: return atan2Turns<hAccuracy::Fast>(y, x);
+		case hAccuracy::Coarse: return atan2Turns<hAccuracy::Coarse>(y, x);
+		default: return atan2Turns<hAccuracy::Exact>(y, x);
+		}
+	}
+
+	/// Write the heading in turns of every vector in <paramref name="xs"/>, <paramref name="ys"/> to <paramref name="tau"/>. See <see cref="atan2Turns"/> for the error bounds.
+	inline void findRotations(std::span<const hType_f> xs, std::span<const hType_f> ys, std::span<hType_f> tau, hAccuracy accuracy = hAccuracy::Exact) {
+		assert(ys.size() >= xs.size() && tau.size() >= xs.size());
+		const hType_f* px = xs.data();
+		const hType_f* py = ys.data();
+		hType_f* po = tau.data();
+		const std::size_t n = xs.size();
+		switch (accuracy) {
+		case hAccuracy::Fast:
+			for (std::size_t i = 0; i < n; ++i)
+				po[i] = atan2Turns<hAccuracy::Fast>(py[i], px[i]);
+			break;
+		case hAccuracy::Coarse:
+			for (std::size_t i = 0; i < n; ++i)
+				po[i] = atan2Turns<hAccuracy::Coarse>(py[i], px[i]);
+			break;
+		default:
+			for (std::size_t i = 0; i < n; ++i)
+				po[i] = atan2Turns<hAccuracy::Exact>(py[i], px[i]);
+			break;
+		}
+	}
+
+	inline void findRotations(const hVectorBatch& vectors, std::span<hType_f> tau, hAccuracy accuracy = hAccuracy::Exact) {
+		findRotations(vectors.x, vectors.y, tau, accuracy);
+	}
+
+	inline void findRotations(std::span<const hVector> vectors, std::span<hRotation> out, hAccuracy accuracy = hAccuracy::Exact) {
+		assert(out.size() >= vectors.size());
+		for (std::size_t i = 0; i < vectors.size(); ++i)
+			out[i] = hRotation(atan2Turns(vectors[i].y, vectors[i].x, accuracy));
+	}
+
+	/// <summary>
+	/// Fill <paramref name="out"/> with the distance from every vector in <paramref name="from"/> to every vector in <paramref name="to"/>,
+	/// row-major with <c>out[i * to.size() + j]</c> holding the distance from <c>from[i]</c> to <c>to[j]</c>.
+	/// Targets are processed in tiles that stay in cache across all rows. Pass <paramref name="squared"/> to skip the square root.
+	/// </summary>
+	inline void distanceMatrix(const hVectorBatch& from, const hVectorBatch& to, std::span<hType_f> out, bool squared = false) {
+		constexpr std::size_t TILE = 512;
+		const std::size_t rows = from.size();
+		const std::size_t cols = to.size();
+		assert(out.size() >= rows * cols);
+		const hType_f* tx = to.x.data();
+		const hType_f* ty = to.y.data();
+		hType_f* po = out.data();
+
+		for (std::size_t j0 = 0; j0 < cols; j0 += TILE) {
+			const std::size_t j1 = std::min(cols, j0 + TILE);
+			for (std::size_t i = 0; i < rows; ++i) {
+				const hType_f fx = from.x[i];
+				const hType_f fy = from.y[i];
+				hType_f* row = po + i * cols;
+				for (std::size_t j = j0; j < j1; ++j) {
+					const hType_f dx = tx[j] - fx;
+					const hType_f dy = ty[j] - fy;
+					row[j] = dx * dx + dy * dy;
+				}
+				if (!squared)
+					for (std::size_t j = j0; j < j1; ++j)
+						row[j] = std::sqrt(row[j]);
+			}
+		}
+	}
+
+	/// <summary>
+	/// For every vector in <paramref name="from"/>, write the index of and distance to the closest vector in <paramref name="to"/>.
+	/// If <paramref name="to"/> is empty every index is SIZE_MAX and every distance is infinite.
+	/// </summary>
+	inline void nearest(const hVectorBatch& from, const hVectorBatch& to, std::span<std::size_t> index, std::span<hType_f> distances) {
+		constexpr std::size_t TILE = 512;
+		const std::size_t rows = from.size();
+		const std::size_t cols = to.size();
+		assert(index.size() >= rows && distances.size() >= rows);
+		std::fill_n(index.begin(), rows, SIZE_MAX);
+		std::fill_n(distances.begin(), rows, std::numeric_limits<hType_f>::infinity());
+		const hType_f* tx = to.x.data();
+		const hType_f* ty = to.y.data();
+		hType_f d2[TILE];
+
+		for (std::size_t j0 = 0; j0 < cols; j0 += TILE) {
+			const std::size_t n = std::min(TILE, cols - j0);
+			for (std::size_t i = 0; i < rows; ++i) {
+				const hType_f fx = from.x[i];
+				const hType_f fy = from.y[i];
+				for (std::size_t j = 0; j < n; ++j) {
+					const hType_f dx = tx[j0 + j] - fx;
+					const hType_f dy = ty[j0 + j] - fy;
+					d2[j] = dx * dx + dy * dy;
+				}
+				hType_f best = distances[i];
+				std::size_t best_j = index[i];
+				for (std::size_t j = 0; j < n; ++j) {
+					if (d2[j] < best) {
+						best = d2[j];
+						best_j = j0 + j;
+					}
+				}
+				distances[i] = best;
+				index[i] = best_j;
+			}
+		}
+		if (cols > 0)
+			for (std::size_t i = 0; i < rows; ++i)
+				distances[i] = std::sqrt(distances[i]);
+	}
+
+
 	/******************************************************************************************************************
 		hArea Operations
 	******************************************************************************************************************/
 
-	inline bool overlapping(const hArea& a, const hArea& b) {
+	constexpr bool overlapping(const hArea& a, const hArea& b) {
 		return !(a.x1 > b.x2 || a.y1 > b.y2 || b.x1 > a.x2 || b.y1 > a.y2);
 	}
 
-	inline bool contains(const hArea& a, const hArea& b) {
-		return b.x1 >= a.x1 && b.y1 >= a.y1 && b.x2 <= a.x2 && b.y2 <= a.x2;
+	constexpr bool contains(const hArea& a, const hArea& b) {
+		return b.x1 >= a.x1 && b.y1 >= a.y1 && b.x2 <= a.x2 && b.y2 <= a.y2;
 	}
 
-	inline bool contains(const hArea& a, const hPoint& b) {
-		return b.x >= a.x1 && b.y >= a.y1 && b.x < a.x2&& b.y < a.x2;
+	constexpr bool contains(const hArea& a, const hPoint& b) {
+		return b.x >= a.x1 && b.y >= a.y1 && b.x < a.x2 && b.y < a.y2;
 	}
 
-	inline bool isEdgePoint(const hArea& rec, const hPoint& pos) {
+	constexpr bool isEdgePoint(const hArea& rec, const hPoint& pos) {
 		return pos.x == rec.x1 || pos.x == rec.x2 - 1_hi || pos.y == rec.y1 || pos.y == rec.y2 - 1_hi;
 	}
 
 	/// Create an Area object from the extreme points of two areas.
-	inline hArea makeAreaBoundary(const hArea& a, const hArea& b) {
+	constexpr hArea makeAreaBoundary(const hArea& a, const hArea& b) {
 		return hArea(std::min(a.x1, b.x1), std::min(a.y1, b.y1), std::max(a.x2, b.x2), std::max(a.y2, b.y2));
 	}
 
+	/// <summary>
+	/// Find the component-wise minimum and maximum of a non-empty span of points.
+	/// The loop keeps independent accumulator lanes so the compiler can vectorize it without a serial min/max dependency.
+	/// </summary>
+	template <typename T>
+	inline void extents(std::span<const ITuple<T>> pts, ITuple<T>& lo, ITuple<T>& hi) {
+		assert(!pts.empty());
+		constexpr std::size_t L = 8;
+		T min_x[L], min_y[L], max_x[L], max_y[L];
+		for (std::size_t l = 0; l < L; ++l) {
+			min_x[l] = max_x[l] = pts[0].x;
+			min_y[l] = max_y[l] = pts[0].y;
+		}
+
+		const std::size_t n = pts.size() - pts.size() % L;
+		for (std::size_t i = 0; i < n; i += L) {
+			for (std::size_t l = 0; l < L; ++l) {
+				const T x = pts[i + l].x;
+				const T y = pts[i + l].y;
+				min_x[l] = x < min_x[l] ? x : min_x[l];
+				min_y[l] = y < min_y[l] ? y : min_y[l];
+				max_x[l] = x > max_x[l] ? x : max_x[l];
+				max_y[l] = y > max_y[l] ? y : max_y[l];
+			}
+		}
+		for (std::size_t i = n; i < pts.size(); ++i) {
+			min_x[0] = std::min(min_x[0], pts[i].x);
+			min_y[0] = std::min(min_y[0], pts[i].y);
+			max_x[0] = std::max(max_x[0], pts[i].x);
+			max_y[0] = std::max(max_y[0], pts[i].y);
+		}
+
+		lo = { min_x[0], min_y[0] };
+		hi = { max_x[0], max_y[0] };
+		for (std::size_t l = 1; l < L; ++l) {
+			lo.x = std::min(lo.x, min_x[l]);
+			lo.y = std::min(lo.y, min_y[l]);
+			hi.x = std::max(hi.x, max_x[l]);
+			hi.y = std::max(hi.y, max_y[l]);
+		}
+	}
+
+	/// <summary>
+	/// Same as <see cref="extents"/>, but spans of at least <paramref name="parallel_threshold"/> points are split
+	/// into one contiguous chunk per hardware thread and the partial results merged.
+	/// </summary>
+	template <typename T>
+	inline void extents(std::span<const ITuple<T>> pts, ITuple<T>& lo, ITuple<T>& hi, std::size_t parallel_threshold) {
+		const std::size_t workers = std::min<std::size_t>(std::thread::hardware_concurrency(), pts.size() / 4096 + 1);
+		if (pts.size() < parallel_threshold || workers < 2) {
+			extents(pts, lo, hi);
+			return;
+		}
+
+		const std::size_t chunk = (pts.size() + workers - 1) / workers;
+		std::vector<ITuple<T>> los(workers), his(workers);
+		// jthread joins on destruction, so a failure to start a worker can fall back to the serial path
+		std::vector<std::jthread> threads;
+		threads.reserve(workers - 1);
+		try {
+			for (std::size_t w = 1; w < workers && w * chunk < pts.size(); ++w) {
+				threads.emplace_back([&, w]() {
+					extents(pts.subspan(w * chunk, std::min(chunk, pts.size() - w * chunk)), los[w], his[w]);
+				});
+			}
+		}
+		catch (const std::system_error&) {
+			threads.clear();
+			extents(pts, lo, hi);
+			return;
+		}
+		extents(pts.first(chunk), lo, hi);
+		for (std::size_t w = 0; w < threads.size(); ++w) {
+			threads[w].join();
+			lo.x = std::min(lo.x, los[w + 1].x);
+			lo.y = std::min(lo.y, los[w + 1].y);
+			hi.x = std::max(hi.x, his[w + 1].x);
+			hi.y = std::max(hi.y, his[w + 1].y);
+		}
+	}
+
+	/// Create an hArea object based on the boundary from a span of points. An empty span yields an empty hArea.
+	inline hArea makeAreaBoundary(std::span<const hPoint> pts, std::size_t parallel_threshold = H_PARALLEL_THRESHOLD) {
+		if (pts.empty())
+			return hArea();
+		hPoint lo, hi;
+		extents(pts, lo, hi, parallel_threshold);
+		return hArea(lo, hi);
+	}
+
 	/// Create an hArea object based on the boundary from a list of points.
 	inline hArea makeAreaBoundary(const std::initializer_list<hPoint> pts) {
-		hArea r (pts.begin()->x, pts.begin()->y);
-		for (auto p = pts.begin() + 1; p != pts.end(); ++p) {
-			r.x1 = std::min(r.x1, p->x);
-			r.y1 = std::min(r.y1, p->y);
-			r.x2 = std::max(r.x2, p->x);
-			r.y2 = std::max(r.y2, p->y);
-		}
-		return r;
+		return makeAreaBoundary(std::span<const hPoint>(pts.begin(), pts.size()));
+	}
+
+	/// <summary>
+	/// Compute the boundary of many point sets at once. Set <c>i</c> is <c>points[offsets[i], offsets[i + 1])</c>,
+	/// so <paramref name="offsets"/> holds one more entry than <paramref name="out"/>.
+	/// </summary>
+	inline void makeAreaBoundaries(std::span<const hPoint> points, std::span<const std::size_t> offsets, std::span<hArea> out) {
+		assert(offsets.size() >= out.size() + 1);
+		for (std::size_t i = 0; i < out.size(); ++i)
+			out[i] = makeAreaBoundary(points.subspan(offsets[i], offsets[i + 1] - offsets[i]), SIZE_MAX);
 	}
 
 	/// Create an hArea object ussing a position and radius.
-	inline hArea makeAreaRadius(const hPoint pos, const hType_i radius) {
+	constexpr hArea makeAreaRadius(const hPoint pos, const hType_i radius) {
 		return hArea(pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius);
 	}
 
 	/// Create an hArea object using offset, size.
-	inline hArea makeAreaOffsetAndSize(const hPoint offset, const hPoint size) {
+	constexpr hArea makeAreaOffsetAndSize(const hPoint offset, const hPoint size) {
 		return hArea(offset.x, offset.y, offset.x + size.x, offset.y + size.y);
 	}
 
@@ -133,7 +560,7 @@ namespace hrzn {
 	/// </summary>
 	/// <param name="area">The <type>hArea</type> to be split</param>
 	/// <returns>A container with the new URect objects. If <paramref name="rec"/> is only a single cell (width and height are equal to 1), then both are simply a copy of the orignal parameter. </returns>
-	inline std::pair<hArea, hArea> split(const hArea& area) {
+	constexpr std::pair<hArea, hArea> split(const hArea& area) {
 		hArea a1 = area;
 		hArea a2 = area;
 		hPoint cp = area.center();
@@ -157,12 +584,7 @@ namespace hrzn {
 	/// </summary>
 	template <typename T>
 	inline bool compare(const IMap<T>& a, const IMap<T>& b) {
-		hArea area = hrzn::intersect(a, b);
-		HRZN_FOREACH_POINT(area, x, y) {
-			if (a.at(x, y) != b.at(x, y))
-				return false;
-		}
-		return true;
+		return zipAllOf(a, [](const T& x, const T& y) { return x == y; }, a, b);
 	}
 
 	/// <summary>
@@ -170,10 +592,7 @@ namespace hrzn {
 	/// </summary>
 	template <typename Ta, typename Tb>
 	inline void copy(const IMap<Ta>& from, IMap<Tb>& to, Ta(*cast)(Tb) = [](Tb val)->Ta {return static_cast<Ta>(val); }) {
-		hArea area = hrzn::intersect(from, to);
-		HRZN_FOREACH_POINT(area, x, y) {
-			to.set(x, y, cast(from.at(x, y)));
-		}
+		zipForEach(from, [cast](const Ta& f, Tb& t) { t = cast(f); }, from, to);
 	}
 
 	/// <summary>
@@ -212,11 +631,7 @@ namespace hrzn {
 
 	template <typename T>
 	inline void maskfill(IMap<T>& map, const T& fill_obj, const IMap<bool>& mask) {
-		hArea fill_area = hrzn::intersect(map, mask);
-		HRZN_FOREACH_POINT(fill_area, x, y) {
-			if (mask.at(x, y))
-				map.set(x, y, fill_obj);
-		}
+		zipForEach(map, [&fill_obj](T& cell, bool m) { if (m) cell = fill_obj; }, map, mask);
 	}
 
 	template <typename T>
@@ -246,12 +661,7 @@ namespace hrzn {
 	template <typename T>
 	inline HMap<T> transposeListToMap(hArea area, T* list) {
 		HMap<T> map(area);
-
-		for (int x = map.x1; x < map.x2; ++x) {
-			for (int y = map.y1; y < map.y2; ++y)
-				map.set(x, y, *list);
-			list++;
-		}
+		std::copy_n(list, map.area(), map.data());
 		return map;
 	}
 
@@ -259,9 +669,8 @@ namespace hrzn {
 	inline std::vector<T> transposeMapToList(const IMap<T>& map) {
 		std::vector<T> list;
 		list.reserve(map.area());
-		int i = 0;
-		for (int y = map.y1; y < map.y2; ++y)
-			for (int x = map.x1; x < map.x2; ++x)
+		for (hType_i y = map.y1; y < map.y2; ++y)
+			for (hType_i x = map.x1; x < map.x2; ++x)
 				list.emplace_back(map.at(x, y));
 		return list;
 	}
@@ -332,20 +741,55 @@ namespace hrzn {
 	******************************************************************************************************************/
 
 
+	/// Bounding box of a non-empty span of points. Spans of at least <paramref name="parallel_threshold"/> points are reduced on multiple threads.
+	inline hBox boundingBox(std::span<const hVector> points, std::size_t parallel_threshold = H_PARALLEL_THRESHOLD) {
+		hVector min, max;
+		extents(points, min, max, parallel_threshold);
+		return { min, max };
+	}
+
+	inline hBox boundingBox(hPolygonView polygon) {
+		return boundingBox(polygon.vertices);
+	}
+
 	inline hBox boundingBox(const IPolygon& polygon) {
 		hVector min = polygon.get(0);
 		hVector max = polygon.get(0);
 
-		for (int i = 1; i < polygon.count(); ++i) {
-			min.x = std::min(min.x, polygon.get(i).x);
-			min.y = std::min(min.y, polygon.get(i).y);
-			max.x = std::max(max.x, polygon.get(i).x);
-			max.y = std::max(max.y, polygon.get(i).y);
+		for (std::size_t i = 1; i < polygon.count(); ++i) {
+			hVector v = polygon.get(i);
+			min.x = std::min(min.x, v.x);
+			min.y = std::min(min.y, v.y);
+			max.x = std::max(max.x, v.x);
+			max.y = std::max(max.y, v.y);
 		}
 
 		return { min, max };
 	}
 
+	/// <summary>
+	/// Compute the bounding box of many polygons at once. Polygon <c>i</c> is <c>points[offsets[i], offsets[i + 1])</c>,
+	/// so <paramref name="offsets"/> holds one more entry than <paramref name="out"/>. Empty polygons get a zero-sized box at the origin.
+	/// </summary>
+	inline void boundingBoxes(std::span<const hVector> points, std::span<const std::size_t> offsets, std::span<hBox> out) {
+		assert(offsets.size() >= out.size() + 1);
+		for (std::size_t i = 0; i < out.size(); ++i) {
+			if (offsets[i] == offsets[i + 1]) {
+				out[i] = hBox(0._hf, 0._hf, 0._hf, 0._hf);
+				continue;
+			}
+			hVector min, max;
+			extents(points.subspan(offsets[i], offsets[i + 1] - offsets[i]), min, max);
+			out[i] = hBox(min, max);
+		}
+	}
+
+	/// Compute the bounding box of every polygon in an arena into <paramref name="out"/>, which must hold at least <c>polygons.size()</c> boxes.
+	inline void boundingBoxes(const hPolygonArena& polygons, std::span<hBox> out) {
+		assert(out.size() >= polygons.size());
+		boundingBoxes(polygons.vertices, polygons.offsets, out.first(polygons.size()));
+	}
+
 
 	/******************************************************************************************************************
 		Lerping Methods
@@ -360,16 +804,11 @@ namespace hrzn {
 			return { lerp(a.x, b.x, f), lerp(a.y, b.y, f) };
 		}
 
+		/// Interpolate between two rotations along the shortest path.
 		inline hRotation lerp(const hRotation& a, const hRotation& b, const hType_f& f) {
-			hType_f t_a = a.tau;
-			hType_f t_b = b.tau;
-			if (std::abs(t_a - t_b) >= 1._hf) {
-				if (t_a > t_b)
-					t_a = t_a - 1._hf;
-				else
-					t_b = t_b - 1._hf;
-			}
-			return {lerp(t_a, t_b, f)};
+			hType_f diff = b.tau - a.tau;
+			diff -= std::floor(diff + 0.5_hf);
+			return { a.tau + diff * f };
 		}
 
 		inline hTransform lerp(const hTransform& a, const hTransform& b, const hType_f& f) {
@@ -5,6 +5,15 @@
 
 #include "../include/htl/hrzn.h"
 #include "../include/htl/utility.h"
+#include "../include/htl/hierarchy.h"
+#include "../include/htl/animation.h"
+#include "../include/htl/collision.h"
+#include "../include/htl/geometry.h"
+#include "../include/htl/path.h"
+#include "../include/htl/layers.h"
+#include "../include/htl/stringify.h"
+#include "../include/htl/parse.h"
+#include "../include/htl/image.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -148,6 +157,91 @@ namespace hrzn
 
 		}
 
+		TEST_METHOD(Constexpr_TupleAreaAndStaticMap) {
+			constexpr hPoint p = hPoint(3, -4) + hPoint(1, 1) * 2;
+			static_assert(p.x == 5 && p.y == -2);
+			static_assert(p.lengthManhattan() == 7 && (~p)[0] == -2);
+
+			constexpr hArea area = hArea(2, 3, 10, 9) + hPoint(1, 1);
+			static_assert(area.first() == hPoint(3, 4) && area.width() == 8 && area.height() == 6);
+			static_assert(hrzn::intersect(area, hArea(0, 0, 5, 5)).area() == 2);
+			static_assert(area.contains(hArea(4, 5, 6, 7)) && !area.contains(hArea(0, 5, 6, 7)));
+
+			constexpr auto room = [] {
+				HMapStatic<char, 5, 4> m('.');
+				for (int i = 0; i < 4; ++i)
+					m.set(m.corner(i), '#');
+				return m;
+			}();
+			static_assert(room.at(0, 0) == '#' && room.at(4, 3) == '#' && room.at(2, 2) == '.');
+
+			HMap<char> copy(room);
+			hrzn::copy(room, copy);
+			Assert::AreEqual('#', copy.at(4, 0), L"Static map copy failure.");
+
+			HMapStatic<int, 3, 3> grid(0);
+			grid.resize(1, 1, 4, 4);
+			Assert::IsTrue(grid.contains(3, 3), L"Static map move failure.");
+			auto grow = [&grid] { grid.resize(0, 0, 5, 5); };
+			Assert::ExpectException<std::length_error>(grow, L"Static map resized.");
+		}
+
+		TEST_METHOD(PerTypePrecision) {
+			Assert::IsTrue(std::is_same_v<hRotation, IRotation<hType_f>> && std::is_same_v<hArea, IArea<hType_i>>, L"Alias mismatch.");
+			Assert::IsTrue(std::is_same_v<hTransform, ITransform<hType_f>> && std::is_same_v<hPolygonView, IPolygonView<hType_f>>, L"Alias mismatch.");
+
+			ITransform<double> world({ 1.0e7, -3.0e6 }, IRotation<double>::Degrees(90.0), { 2.0, 2.0 });
+			ITuple<double> p = world.childPositon({ 0.25, 0.0 });
+			Assert::AreEqual(1.0e7, p.x, 1.0e-6, L"Double precision transform x.");
+			Assert::AreEqual(-3.0e6 + 0.5, p.y, 1.0e-6, L"Double precision transform y.");
+
+			constexpr IArea<long long> big(-(1LL << 40), 0LL, 1LL << 40, 4LL);
+			static_assert(sizeof(std::size_t) < 8 || big.area() == (std::uint64_t(1) << 43));
+			constexpr IArea<long long> wide(-(1LL << 30), 0LL, 1LL << 30, 1LL);
+			static_assert(wide.width() == (std::size_t(1) << 31));
+			Assert::IsTrue(hArea(IArea<long long>(-2, -3, 5, 7)) == hArea(-2, -3, 5, 7), L"Area precision conversion.");
+
+			std::vector<ITuple<double>> square = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 2.0 }, { 0.0, 2.0 } };
+			IPolygonView<double> view(square);
+			Assert::AreEqual(4.0, polygon::signedArea(view), 1.0e-12, L"Double precision polygon area.");
+			Assert::AreEqual(8.0, polygon::perimeterClosed(view), 1.0e-12, L"Double precision polygon perimeter.");
+		}
+
+		TEST_METHOD(CompactPointsAndKeys) {
+			hPoint16 a(-3, 120);
+			hPoint16 b = a + hPoint16(5, -20);
+			Assert::IsTrue(b == hPoint16(2, 100) && sizeof(hPoint16) == 4, L"16 bit tuple arithmetic.");
+
+			Assert::IsTrue(hrzn::fits<std::int16_t>(hPoint(-32768, 32767)), L"Range limits rejected.");
+			Assert::IsFalse(hrzn::fits<std::int16_t>(hPoint(0, 40000)), L"Out of range accepted.");
+			Assert::IsFalse(hrzn::fits<std::uint16_t>(hPoint(-1, 0)), L"Negative accepted as unsigned.");
+			Assert::IsTrue(hrzn::saturate<std::int16_t>(hVector(1.0e6_hf, -1.0e6_hf)) == hPoint16(32767, -32768), L"Saturation failure.");
+			auto overflow = [] { hrzn::narrow<std::int16_t>(hPoint(70000, 0)); };
+			Assert::ExpectException<std::out_of_range>(overflow, L"Checked narrowing did not throw.");
+
+			std::vector<hPoint16> points = { { 4, -1 }, { -7, 3 }, { 2, -1 }, { 0, 0 }, { -32768, 32767 } };
+			std::vector<std::uint32_t> keys(points.size());
+			hrzn::packKeys(points, keys);
+			int error = 0;
+			for (std::size_t i = 0; i < points.size(); ++i) {
+				if (hrzn::unpackKey<std::int16_t>(keys[i]) != points[i]) error++;
+				for (std::size_t j = 0; j < points.size(); ++j) {
+					bool row_major = points[i].y < points[j].y || (points[i].y == points[j].y && points[i].x < points[j].x);
+					if (row_major != (keys[i] < keys[j])) error++;
+				}
+			}
+			Assert::AreEqual(0, error, L"Key round trip or ordering failure.");
+			Assert::IsTrue(hrzn::unpackKey<std::uint16_t>(hrzn::packKey(hPointU16(65535, 7))) == hPointU16(65535, 7), L"Unsigned key round trip.");
+
+			std::vector<hPoint> wide = { { 1, 2 }, { -300, 4000 } };
+			std::vector<hPoint16> narrow(wide.size());
+			Assert::IsTrue(hrzn::narrowPoints(wide, narrow), L"Batch narrowing rejected valid points.");
+			wide.push_back({ 0, 1 << 20 });
+			narrow.resize(wide.size());
+			Assert::IsFalse(hrzn::narrowPoints(wide, narrow), L"Batch narrowing accepted an invalid point.");
+			Assert::AreEqual(std::hash<hPoint16>()(points[0]), std::hash<hPoint16>()(hPoint16(4, -1)), L"Hash is not stable.");
+		}
+
 
 
 	};
@@ -224,6 +318,576 @@ namespace hrzn
 			}
 			Assert::AreEqual(ref1.area(), c1, L"Source map sub-area does not map reference map.");
 		}
+
+		TEST_METHOD(HMap_WideIndexing) {
+			hArea wide = { -2000000000, -5, 2000000000, 3 };
+			Assert::AreEqual(std::size_t(4000000000ull), wide.width(), L"Width overflowed.");
+			Assert::AreEqual(std::size_t(32000000000ull), wide.area(), L"Area overflowed.");
+
+			hrzn::HMap<int> map({ 0, 0, 3, 3 });
+			for (hType_i y = 0; y < 3; ++y)
+				for (hType_i x = 0; x < 3; ++x)
+					map.row(y)[x] = x + y * 10;
+			Assert::AreEqual(21, map.at(1, 2), L"Row pointer write failure.");
+
+			map.resize(-1, 1, 2, 4, -1);
+			Assert::AreEqual(-1, map.at(-1, 1), L"Resize fill failure.");
+			Assert::AreEqual(11, map.at(1, 1), L"Resize copy failure.");
+			Assert::AreEqual(20, map.row(2)[1], L"Row pointer after resize.");
+			Assert::AreEqual(std::size_t(3), map.stride(), L"Stride failure.");
+		}
+
+		TEST_METHOD(ZipForEach_DifferentOrigins) {
+			hrzn::HMap<int> a({ 0, 0, 10, 10 });
+			hrzn::HMap<int> b({ 3, -2, 20, 8 });
+			hrzn::HMapStatic<bool, 6, 6> mask(hPoint(-1, 1), false);
+			HRZN_FOREACH_POINT(a, x, y) { a.set(x, y, x + y * 100); }
+			HRZN_FOREACH_POINT(b, x, y) { b.set(x, y, -x); }
+			HRZN_FOREACH_POINT(mask, x, y) { mask.set(x, y, (x + y) % 2 == 0); }
+
+			hrzn::HMap<int> out({ -5, -5, 30, 30 }, 0);
+			auto ref = hrzn::ReferenceArea({ 2, 0, 9, 9 }, out);
+			std::size_t calls = 0;
+			hrzn::zipForEach(out, [&calls](int& o, const int& x, const int& y, const bool& m) {
+				o = m ? x + y : -1;
+				calls++;
+			}, ref, a, b, mask);
+
+			int error = 0;
+			HRZN_FOREACH_POINT(out, x, y) {
+				bool inside = x >= 3 && x < 5 && y >= 1 && y < 7;
+				int expect = inside ? (mask.at(x, y) ? a.at(x, y) + b.at(x, y) : -1) : 0;
+				if (out.at(x, y) != expect) error++;
+			}
+			Assert::AreEqual(std::size_t(12), calls, L"Wrong intersection size.");
+			Assert::AreEqual(0, error, L"Zipped cells misaligned.");
+
+			hrzn::HMap<bool> p({ 0, 0, 2, 1 }, false), q({ 0, 0, 2, 1 }, true);
+			p.set(1, 0, true);
+			hrzn::HMap<bool> x = p ^ q;
+			Assert::IsTrue(x.at(0, 0) && !x.at(1, 0), L"Exclusive or failure.");
+
+			calls = 0;
+			bool all = hrzn::zipAllOf(a, [&calls](const int& v, const int& w) { calls++; return v == w; }, a, b);
+			Assert::IsFalse(all, L"Mismatching maps reported equal.");
+			Assert::AreEqual(std::size_t(7), calls, L"zipAllOf should stop after the first failing row.");
+			Assert::IsTrue(hrzn::compare(a, a) && !hrzn::compare(a, b), L"Compare failure.");
+		}
+
+		template <typename TLayered>
+		static void checkLayeredMap() {
+			TLayered world({ -3, -2, 17, 9 }, 0.5f, 7, false);
+			HRZN_FOREACH_POINT(world, x, y) {
+				auto [height, owner, lit] = world.cell(x, y);
+				height = (float)(x * y);
+				owner = x - y;
+				lit = (x + y) % 3 == 0;
+			}
+			Assert::AreEqual(6.0f, world.template at<0>(2, 3), L"Channel 0 lookup.");
+			Assert::AreEqual(-1, world.template at<1>(2, 3), L"Channel 1 lookup.");
+
+			auto owner = world.template layer<1>();
+			auto lit = world.template layer<2>();
+			hrzn::HMap<int> expect({ -3, -2, 17, 9 });
+			HRZN_FOREACH_POINT(expect, x, y) { expect.set(x, y, x - y); }
+			Assert::IsTrue(hrzn::compare<int>(owner, expect), L"Layer view does not match channel.");
+
+			hrzn::maskfill<int>(owner, -100, lit);
+			int error = 0;
+			HRZN_FOREACH_POINT(world, x, y) {
+				int v = world.template at<1>(x, y);
+				if (v != ((x + y) % 3 == 0 ? -100 : x - y)) error++;
+			}
+			Assert::AreEqual(0, error, L"Masked fill through layer views.");
+
+			world.resize(0, 0, 25, 5);
+			Assert::AreEqual(12.0f, world.template at<0>(3, 4), L"Resize kept values.");
+			Assert::AreEqual(0.0f, world.template at<0>(20, 0), L"Resize new cells.");
+		}
+
+		TEST_METHOD(HMapLayered_SoAAndAoSoA) {
+			checkLayeredMap<hrzn::HMapLayered<hrzn::hLayoutSoA, float, int, bool>>();
+			checkLayeredMap<hrzn::HMapLayered<hrzn::hLayoutAoSoA<8>, float, int, bool>>();
+
+			hrzn::HMapLayered<hrzn::hLayoutSoA, float, int> soa({ 0, 0, 4, 4 }, 1.0f, 2);
+			Assert::IsTrue(soa.row<0>(2) != nullptr, L"SoA rows should be contiguous.");
+			std::size_t cells = 0;
+			soa.forEach([&cells](float& f, int& i) { cells += (f == 1.0f && i == 2); });
+			Assert::AreEqual(std::size_t(16), cells, L"forEach failure.");
+		}
+	};
+
+
+
+	TEST_CLASS(HTL_Transform) {
+		TEST_METHOD(hAffine_MatchesTransform) {
+			hTransform tform({ 3._hf, -2._hf }, hRotation(0.2_hf), { 2._hf, 0.5_hf });
+			hAffine mat(tform);
+			hVector pt = { 1.5_hf, -4._hf };
+
+			hVector expected = tform.childPositon(pt);
+			hVector result = mat.apply(pt);
+			Assert::AreEqual(expected.x, result.x, 0.0001_hf, L"Matrix x does not match transform.");
+			Assert::AreEqual(expected.y, result.y, 0.0001_hf, L"Matrix y does not match transform.");
+
+			hVector back = mat.inverse().apply(result);
+			Assert::AreEqual(pt.x, back.x, 0.0001_hf, L"Inverse x failure.");
+			Assert::AreEqual(pt.y, back.y, 0.0001_hf, L"Inverse y failure.");
+		}
+
+		TEST_METHOD(hAffine_Composition) {
+			hTransform parent({ 10._hf, 5._hf }, hRotation(0.125_hf), { 2._hf, 2._hf });
+			hTransform child({ 1._hf, 1._hf }, hRotation(0.3_hf), { 0.5_hf, 0.5_hf });
+			hVector pt = { 2._hf, 3._hf };
+
+			hVector expected = parent.childTransform(child).childPositon(pt);
+			hVector result = (hAffine(parent) * hAffine(child)).apply(pt);
+			Assert::AreEqual(expected.x, result.x, 0.0001_hf, L"Composed x failure.");
+			Assert::AreEqual(expected.y, result.y, 0.0001_hf, L"Composed y failure.");
+		}
+
+		TEST_METHOD(hAffine_TransformQuads) {
+			hQuad quads[2] = { hTransform({ 4._hf, 4._hf }, hRotation(0.1_hf), { 2._hf, 3._hf }), hQuad(5._hf, 1._hf) };
+			hVector corners[8];
+			transformQuads(quads, corners);
+
+			int error = 0;
+			for (int q = 0; q < 2; ++q)
+				for (int i = 0; i < 4; ++i)
+					if (distance(quads[q].get(i), corners[q * 4 + i]) > 0.0001_hf) error++;
+			Assert::AreEqual(0, error, L"Batch quad corners do not match hQuad::get().");
+		}
+
+		TEST_METHOD(HTransformHierarchy_DirtyPropagation) {
+			HTransformHierarchy tree;
+			std::size_t root = tree.add(hTransform({ 5._hf, 0._hf }, hRotation(0.25_hf), { 1._hf, 1._hf }));
+			std::size_t other = tree.add(hTransform({ -3._hf, 2._hf }, hRotation(), { 1._hf, 1._hf }));
+			std::size_t child = tree.add(hTransform({ 1._hf, 0._hf }, hRotation(), { 1._hf, 1._hf }), root);
+			tree.update();
+
+			hVector pos = tree.world(child).apply({ 0._hf, 0._hf });
+			Assert::AreEqual(5._hf, pos.x, 0.0001_hf, L"Child world x failure.");
+			Assert::AreEqual(1._hf, pos.y, 0.0001_hf, L"Child world y failure.");
+
+			hTransform moved = tree.local(root);
+			moved.position = { 0._hf, 0._hf };
+			tree.setLocal(root, moved);
+			tree.update();
+
+			pos = tree.world(child).apply({ 0._hf, 0._hf });
+			Assert::AreEqual(0._hf, pos.x, 0.0001_hf, L"Dirty child x was not propagated.");
+			Assert::AreEqual(1._hf, pos.y, 0.0001_hf, L"Dirty child y was not propagated.");
+			Assert::IsFalse(tree.dirty(child), L"Dirty flag was not cleared.");
+
+			Assert::IsFalse(tree.depthFirst(), L"Interleaved subtree was reported as depth first.");
+			auto remap = tree.sortDepthFirst();
+			Assert::IsTrue(tree.depthFirst(), L"Sorting failure.");
+			Assert::AreEqual(remap[root] + 1, remap[child], L"Child does not follow its parent.");
+			Assert::AreEqual(tree.subtreeEnd(remap[root]), remap[other], L"Subtree range failure.");
+			Assert::AreEqual(std::size_t(2), tree.subtrees().size(), L"Root subtree count failure.");
+		}
+	};
+
+
+
+	TEST_CLASS(HTL_Polygon) {
+		TEST_METHOD(hPolygonView_MatchesPolygon) {
+			hPolygon poly = { { 0._hf, 0._hf }, { 4._hf, 0._hf }, { 4._hf, 3._hf }, { 0._hf, 3._hf } };
+			hPolygonView view = poly.view();
+
+			Assert::AreEqual(11._hf, polygon::perimeter(view), 0.0001_hf, L"View perimeter failure.");
+			Assert::AreEqual(14._hf, polygon::perimeterClosed(view), 0.0001_hf, L"View closed perimeter failure.");
+			Assert::AreEqual(poly.perimeter_closed(), polygon::perimeterClosed(view), 0.0001_hf, L"View and polygon perimeters differ.");
+			Assert::AreEqual(hVector(2._hf, 1.5_hf), polygon::center(view), L"View center failure.");
+		}
+
+		TEST_METHOD(IPolygon_EmitVertices) {
+			hQuad quad(hTransform({ 1._hf, 2._hf }, hRotation(0.3_hf), { 2._hf, 5._hf }));
+			hBox box(1._hf, 2._hf, 5._hf, 7._hf);
+			hVector buffer[4];
+
+			int error = 0;
+			hPolygonView qv = quad.view(buffer);
+			for (std::size_t i = 0; i < 4; ++i)
+				if (distance(qv[i], quad.get(i)) > 0.0001_hf) error++;
+			hPolygonView bv = box.view(buffer);
+			for (std::size_t i = 0; i < 4; ++i)
+				if (bv[i] != box.get(i)) error++;
+			Assert::AreEqual(0, error, L"Emitted vertices do not match get().");
+
+			hBox bounds = boundingBox(bv);
+			Assert::AreEqual(box.v1, bounds.v1, L"Bounding box minimum failure.");
+			Assert::AreEqual(box.v2, bounds.v2, L"Bounding box maximum failure.");
+		}
+
+		TEST_METHOD(Collision_PolygonSAT) {
+			hPolygon a = { { 0._hf, 0._hf }, { 4._hf, 0._hf }, { 4._hf, 4._hf }, { 0._hf, 4._hf } };
+			hPolygon b = { { 3._hf, 1._hf }, { 3._hf, 3._hf }, { 7._hf, 3._hf }, { 7._hf, 1._hf } };
+			hPolygon c = { { 5._hf, 0._hf }, { 9._hf, 0._hf }, { 7._hf, 3._hf } };
+
+			hContact hit = collision::collide(a, b);
+			Assert::IsTrue(hit.hit, L"Overlapping polygons were not detected.");
+			Assert::AreEqual(1._hf, hit.depth, 0.0001_hf, L"Penetration depth failure.");
+			Assert::AreEqual(hVector(1._hf, 0._hf), hit.penetration(), L"Penetration vector failure.");
+			Assert::AreEqual(std::size_t(2), hit.count, L"Contact point count failure.");
+
+			Assert::IsFalse(collision::collide(a, c).hit, L"False positive for separated polygons.");
+
+			hPolygon repeated = { { 0._hf, 0._hf }, { 2._hf, 0._hf }, { 2._hf, 0._hf }, { 2._hf, 2._hf }, { 0._hf, 2._hf } };
+			hPolygon offset = { { 1._hf, 1._hf }, { 3._hf, 1._hf }, { 3._hf, 3._hf }, { 1._hf, 3._hf } };
+			hit = collision::collide(repeated, offset);
+			Assert::IsTrue(hit.hit, L"Overlap with a repeated vertex was not detected.");
+			Assert::AreEqual(1._hf, hit.depth, 0.0001_hf, L"Zero length edge chosen as the separating axis.");
+			Assert::AreEqual(1._hf, std::abs(hit.normal.x) + std::abs(hit.normal.y), 0.0001_hf, L"Zero length edge normal.");
+		}
+
+		TEST_METHOD(Collision_TouchingShapes) {
+			hQuad a(hTransform({ 0._hf, 0._hf }, hRotation(), { 1._hf, 1._hf }));
+			hQuad b(hTransform({ 1._hf, 0._hf }, hRotation(), { 1._hf, 1._hf }));
+			Assert::IsFalse(collision::collide(a, b).hit, L"Touching boxes reported as a hit.");
+			Assert::IsFalse(collision::collide(static_cast<const IPolygon&>(a), static_cast<const IPolygon&>(b)).hit, L"Touching polygons reported as a hit.");
+		}
+
+		TEST_METHOD(Collision_QuadFastPathAndBatch) {
+			hQuad a(hTransform({ 0._hf, 0._hf }, hRotation(0.125_hf), { 2._hf, 2._hf }));
+			hQuad b(hTransform({ 1.5_hf, 0.2_hf }, hRotation(0.05_hf), { 2._hf, 1._hf }));
+			hQuad c(hTransform({ 10._hf, 0._hf }, hRotation(), { 1._hf, 1._hf }));
+
+			hContact fast = collision::collide(a, b);
+			hContact slow = collision::collide(static_cast<const IPolygon&>(a), static_cast<const IPolygon&>(b));
+			Assert::IsTrue(fast.hit && slow.hit, L"Overlapping quads were not detected.");
+			Assert::AreEqual(slow.depth, fast.depth, 0.0001_hf, L"Fast path depth does not match polygon test.");
+			Assert::IsTrue(distance(slow.normal, fast.normal) < 0.0001_hf, L"Fast path normal does not match polygon test.");
+
+			hOBBBatch boxes;
+			boxes.push_back(hOBB(a));
+			boxes.push_back(hOBB(b));
+			boxes.push_back(hOBB(c));
+			std::uint32_t first[] = { 0, 0 };
+			std::uint32_t second[] = { 1, 2 };
+			hContact out[2];
+			collision::collide(boxes, first, second, out);
+			Assert::IsTrue(out[0].hit, L"Batch missed a collision.");
+			Assert::IsFalse(out[1].hit, L"Batch false positive.");
+			Assert::AreEqual(fast.depth, out[0].depth, 0.0001_hf, L"Batch depth failure.");
+			Assert::AreEqual(fast.count, out[0].count, L"Batch contact count failure.");
+		}
+
+		TEST_METHOD(Collision_BatchPointInPolygon) {
+			// A concave "U" shape.
+			hPolygon poly = { { 0._hf, 0._hf }, { 6._hf, 0._hf }, { 6._hf, 6._hf }, { 4._hf, 6._hf }, { 4._hf, 2._hf }, { 2._hf, 2._hf }, { 2._hf, 6._hf }, { 0._hf, 6._hf } };
+			std::vector<hVector> points;
+			for (int y = -1; y < 8; ++y)
+				for (int x = -1; x < 8; ++x)
+					for (int i = 0; i < 3; ++i)
+						points.emplace_back(x + 0.5_hf, y + 0.5_hf);
+
+			std::vector<std::uint64_t> mask(collision::maskWords(points.size()));
+			std::vector<std::uint64_t> slab_mask(collision::maskWords(points.size()));
+			collision::contains(poly.view(), points, mask);
+			hPolygonSlabs slabs(poly.view());
+			collision::contains(slabs, points, slab_mask);
+
+			int error = 0;
+			for (std::size_t i = 0; i < points.size(); ++i) {
+				bool expected = collision::winding(poly.view(), points[i]) != 0;
+				if (collision::maskTest(mask, i) != expected) error++;
+				if (collision::maskTest(slab_mask, i) != expected) error++;
+			}
+			Assert::AreEqual(0, error, L"Batch point in polygon failure.");
+			Assert::IsTrue(collision::winding(poly.view(), { 1._hf, 5._hf }) != 0, L"Point in left arm failure.");
+			Assert::IsTrue(collision::winding(poly.view(), { 3._hf, 5._hf }) == 0, L"Point in notch failure.");
+		}
+
+		TEST_METHOD(Collision_BatchPointInArea) {
+			hArea area = { -2, 3, 5, 9 };
+			std::vector<hPoint> points;
+			for (int y = 0; y < 12; ++y)
+				for (int x = -5; x < 8; ++x)
+					points.emplace_back(x, y);
+
+			std::vector<std::uint64_t> mask(collision::maskWords(points.size()));
+			collision::contains(area, points, mask);
+
+			int error = 0;
+			for (std::size_t i = 0; i < points.size(); ++i)
+				if (collision::maskTest(mask, i) != area.contains(points[i])) error++;
+			Assert::AreEqual(0, error, L"Batch point in area failure.");
+		}
+
+		TEST_METHOD(Clipper_BoxAndConvex) {
+			HPolygonClipper clipper;
+			hPolygon square = { { 0._hf, 0._hf }, { 4._hf, 0._hf }, { 4._hf, 4._hf }, { 0._hf, 4._hf } };
+
+			hPolygonView clipped = clipper.clip(square.view(), hArea(2, 2, 10, 10));
+			Assert::AreEqual(std::size_t(4), clipped.count(), L"Box clip vertex count failure.");
+			Assert::AreEqual(4._hf, std::abs(polygon::signedArea(clipped)), 0.0001_hf, L"Box clip area failure.");
+
+			hPolygon triangle = { { 2._hf, -2._hf }, { 6._hf, 2._hf }, { 2._hf, 6._hf } };
+			clipped = clipper.clip(square.view(), triangle.view());
+			Assert::AreEqual(8._hf, std::abs(polygon::signedArea(clipped)), 0.0001_hf, L"Convex clip area failure.");
+
+			clipped = clipper.clip(clipper.clip(square.view(), hArea(0, 1, 10, 10)), triangle.view());
+			Assert::AreEqual(6._hf, std::abs(polygon::signedArea(clipped)), 0.0001_hf, L"Chained clip area failure.");
+
+			hPolygonArena subjects, out;
+			subjects.push_back(square);
+			subjects.push_back(hPolygon{ { 20._hf, 20._hf }, { 21._hf, 20._hf }, { 21._hf, 21._hf } });
+			clipper.clip(subjects, hBox(1._hf, 1._hf, 3._hf, 3._hf), out);
+			Assert::AreEqual(std::size_t(2), out.size(), L"Batch clip polygon count failure.");
+			Assert::AreEqual(4._hf, std::abs(polygon::signedArea(out[0])), 0.0001_hf, L"Batch clip area failure.");
+			Assert::AreEqual(std::size_t(0), out[1].count(), L"Clipped away polygon should be empty.");
+
+			hPolygon diamond = { { 2._hf, 0._hf }, { 4._hf, 2._hf }, { 2._hf, 4._hf }, { 0._hf, 2._hf } };
+			hPolygonArena batch;
+			batch.push_back(diamond);
+			batch.push_back(square);
+			clipper.clip(batch, hBox(1._hf, 1._hf, 3._hf, 3._hf), out);
+			Assert::AreEqual(std::size_t(8), out[2].count(), L"Each box plane should cut a diamond corner.");
+
+			clipper.clip(batch, hBox(1._hf, 1._hf, 3._hf, 3._hf), batch);
+			Assert::AreEqual(std::size_t(4), batch.size(), L"In place clip should append one result per input.");
+			Assert::AreEqual(4._hf, std::abs(polygon::signedArea(batch[3])), 0.0001_hf, L"In place clip area failure.");
+		}
+
+		TEST_METHOD(Triangulator_PolygonWithHole) {
+			hPolygon outer = { { 0._hf, 0._hf }, { 10._hf, 0._hf }, { 10._hf, 10._hf }, { 0._hf, 10._hf } };
+			hPolygon hole = { { 3._hf, 3._hf }, { 3._hf, 7._hf }, { 7._hf, 7._hf }, { 7._hf, 3._hf } };
+			hPolygonView holes[] = { hole.view() };
+			std::vector<hVector> vertices = outer.vertices;
+			vertices.insert(vertices.end(), hole.vertices.begin(), hole.vertices.end());
+
+			std::vector<std::uint32_t> indices(HTriangulator::indexCount(vertices.size(), 1));
+			HTriangulator triangulator;
+			std::size_t count = triangulator.triangulate(outer.view(), holes, indices);
+			Assert::AreEqual(std::size_t(24), count, L"Triangle count failure.");
+
+			hType_f area = 0._hf;
+			int clockwise = 0;
+			for (std::size_t i = 0; i < count; i += 3) {
+				hVector tri[] = { vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]] };
+				hType_f a = polygon::signedArea(hPolygonView(tri));
+				if (a < 0._hf) clockwise++;
+				area += a;
+			}
+			Assert::AreEqual(0, clockwise, L"Triangles are not counter-clockwise.");
+			Assert::AreEqual(84._hf, area, 0.001_hf, L"Triangulated area does not match polygon area.");
+		}
+
+		TEST_METHOD(Simplifier_ConvexHull) {
+			std::vector<hVector> points;
+			for (int y = 0; y < 5; ++y)
+				for (int x = 0; x < 5; ++x)
+					points.emplace_back(x, y);
+			points.emplace_back(2._hf, 6._hf);
+
+			HPolygonSimplifier simplifier;
+			std::vector<hVector> hull;
+			simplifier.convexHull(points, hull);
+			Assert::AreEqual(std::size_t(5), hull.size(), L"Hull vertex count failure.");
+			Assert::IsTrue(polygon::signedArea(hPolygonView(hull)) > 0._hf, L"Hull is not counter-clockwise.");
+			Assert::AreEqual(20._hf, polygon::signedArea(hPolygonView(hull)), 0.0001_hf, L"Hull area failure.");
+		}
+
+		TEST_METHOD(Simplifier_CollinearContour) {
+			// A square outline sampled at every unit, with a little noise on one side.
+			std::vector<hVector> contour;
+			for (int i = 0; i < 10; ++i) contour.emplace_back(i * 1._hf, (i % 2) * 0.01_hf);
+			for (int i = 0; i < 10; ++i) contour.emplace_back(10, i);
+			for (int i = 10; i > 0; --i) contour.emplace_back(i, 10);
+			for (int i = 10; i > 0; --i) contour.emplace_back(0, i);
+
+			HPolygonSimplifier simplifier;
+			std::vector<hVector> out;
+			simplifier.douglasPeucker(contour, 0.1_hf, out, true);
+			Assert::AreEqual(std::size_t(4), out.size(), L"Douglas-Peucker closed contour failure.");
+
+			simplifier.visvalingam(contour, 0.1_hf, out, true);
+			Assert::AreEqual(std::size_t(4), out.size(), L"Visvalingam closed contour failure.");
+
+			std::vector<hVector> line = { { 0._hf, 0._hf }, { 1._hf, 0._hf }, { 2._hf, 0._hf }, { 2._hf, 1._hf } };
+			simplifier.douglasPeucker(line, 0.1_hf, out);
+			Assert::AreEqual(std::size_t(3), out.size(), L"Douglas-Peucker open polyline failure.");
+			Assert::AreEqual(hVector(2._hf, 1._hf), out.back(), L"Open polyline end point was removed.");
+		}
+	};
+
+
+
+	TEST_CLASS(HTL_Path) {
+		TEST_METHOD(HPolyline_DistanceLookup) {
+			std::vector<hVector> points = { { 0._hf, 0._hf }, { 3._hf, 0._hf }, { 3._hf, 4._hf }, { 0._hf, 4._hf } };
+			HPolyline path(points);
+			Assert::AreEqual(10._hf, path.length(), 0.0001_hf, L"Open path length failure.");
+			Assert::AreEqual(hVector(3._hf, 2._hf), path.at(5._hf), L"Position at distance failure.");
+			Assert::AreEqual(hVector(0._hf, 4._hf), path.at(50._hf), L"Distance past the end should clamp.");
+
+			HPolyline loop(points, true);
+			Assert::AreEqual(14._hf, loop.length(), 0.0001_hf, L"Closed path length failure.");
+			Assert::AreEqual(hVector(0._hf, 2._hf), loop.at(26._hf), L"Closed path wrap failure.");
+
+			hPolylineCursor cursor;
+			int error = 0;
+			for (hType_f d = 0._hf; d < 10._hf; d += 0.25_hf)
+				if (distance(path.at(d), path.at(d, cursor)) > 0.0001_hf) error++;
+			Assert::AreEqual(0, error, L"Cursor sampling does not match binary search.");
+
+			std::vector<hVector> resampled;
+			path.resample(1._hf, resampled);
+			Assert::AreEqual(std::size_t(11), resampled.size(), L"Resample count failure.");
+			Assert::AreEqual(hVector(3._hf, 1._hf), resampled[4], L"Resample position failure.");
+		}
+
+		TEST_METHOD(HSpline_Evaluation) {
+			std::vector<hVector> points = { { 0._hf, 0._hf }, { 1._hf, 3._hf }, { 4._hf, 3._hf }, { 6._hf, 0._hf }, { 8._hf, -2._hf } };
+
+			HSpline catmull = HSpline::CatmullRom(points);
+			Assert::AreEqual(std::size_t(4), catmull.segmentCount(), L"Catmull-Rom segment count failure.");
+			int error = 0;
+			for (std::size_t i = 0; i < points.size(); ++i)
+				if (distance(catmull.at(static_cast<hType_f>(i)), points[i]) > 0.0001_hf) error++;
+			Assert::AreEqual(0, error, L"Catmull-Rom does not pass through its control points.");
+
+			std::vector<hVector> bezier_points(points.begin(), points.begin() + 4);
+			HSpline bezier = HSpline::Bezier(bezier_points);
+			Assert::IsTrue(distance(bezier.at(0.5_hf), { 2.625_hf, 2.25_hf }) < 0.0001_hf, L"Bezier midpoint failure.");
+
+			HSpline bspline = HSpline::BSpline(points);
+			Assert::IsTrue(distance(bspline.at(0._hf), (points[0] + points[1] * 4._hf + points[2]) / 6._hf) < 0.0001_hf, L"B-spline start point failure.");
+
+			hType_f u[] = { 0.25_hf, 1.5_hf, 3.9_hf };
+			hVector out[3];
+			catmull.evaluate(u, out);
+			for (std::size_t i = 0; i < 3; ++i)
+				if (distance(out[i], catmull.at(u[i])) > 0.0001_hf) error++;
+			Assert::AreEqual(0, error, L"Batch evaluation failure.");
+		}
+
+		TEST_METHOD(HSpline_FlattenWithinTolerance) {
+			std::vector<hVector> points = { { 0._hf, 0._hf }, { 0._hf, 10._hf }, { 10._hf, 10._hf }, { 10._hf, 0._hf } };
+			HSpline bezier = HSpline::Bezier(points);
+			std::vector<hVector> line;
+			bezier.flatten(0.05_hf, line);
+			Assert::IsTrue(line.size() > 4, L"Curve was not subdivided.");
+
+			int error = 0;
+			for (hType_f u = 0._hf; u <= 1._hf; u += 0.01_hf) {
+				hVector p = bezier.at(u);
+				hType_f best = std::numeric_limits<hType_f>::max();
+				for (std::size_t i = 0; i + 1 < line.size(); ++i) {
+					hVector ab = line[i + 1] - line[i];
+					hType_f t = std::clamp(dotProduct(p - line[i], ab) / ab.lengthSqr(), 0._hf, 1._hf);
+					best = std::min(best, distance(p, line[i] + ab * t));
+				}
+				if (best > 0.05_hf) error++;
+			}
+			Assert::AreEqual(0, error, L"Flattened curve exceeds tolerance.");
+		}
+
+		TEST_METHOD(SegmentIntersector_PolygonSet) {
+			hPolygonArena polygons;
+			// A bow tie crosses itself once, the square crosses the bow tie twice.
+			polygons.push_back(hPolygon{ { 0._hf, 0._hf }, { 4._hf, 4._hf }, { 4._hf, 0._hf }, { 0._hf, 4._hf } });
+			polygons.push_back(hPolygon{ { 3.5_hf, -1._hf }, { 6._hf, -1._hf }, { 6._hf, 1._hf }, { 3.5_hf, 1._hf } });
+			polygons.push_back(hPolygon{ { 10._hf, 10._hf }, { 12._hf, 10._hf }, { 11._hf, 12._hf } });
+
+			HSegmentIntersector intersector;
+			std::vector<hSegmentIntersection> hits;
+			intersector.intersect(polygons, hits);
+			Assert::AreEqual(std::size_t(3), hits.size(), L"Crossing count failure.");
+
+			int self = 0;
+			for (const auto& hit : hits)
+				if (hit.b < 4 && distance(hit.point, { 2._hf, 2._hf }) < 0.0001_hf) self++;
+			Assert::AreEqual(1, self, L"Self intersection of the bow tie was not found.");
+
+			std::vector<hVector> starts, ends;
+			for (int i = 0; i < 50; ++i) {
+				starts.emplace_back(static_cast<hType_f>(i), 0._hf);
+				ends.emplace_back(static_cast<hType_f>(i), 50._hf);
+				starts.emplace_back(-1._hf, i + 0.5_hf);
+				ends.emplace_back(51._hf, i + 0.5_hf);
+			}
+			hits.clear();
+			intersector.intersect(starts, ends, hits);
+			Assert::AreEqual(std::size_t(2500), hits.size(), L"Grid crossing count failure.");
+		}
+	};
+
+
+
+	TEST_CLASS(HTL_Animation) {
+		TEST_METHOD(Lerp_BatchMatchesScalar) {
+			hTransformBatch a, b, out;
+			a.push_back(hTransform({ 0._hf, 0._hf }, hRotation(0.1_hf), { 1._hf, 1._hf }));
+			b.push_back(hTransform({ 10._hf, -4._hf }, hRotation(0.3_hf), { 3._hf, 2._hf }));
+			a.push_back(hTransform({ 2._hf, 2._hf }, hRotation(0.9_hf), { 1._hf, 1._hf }));
+			b.push_back(hTransform({ 4._hf, 8._hf }, hRotation(0.1_hf), { 1._hf, 5._hf }));
+			hType_f f[] = { 0.25_hf, 0.5_hf };
+
+			lerp::smoothstep(a, b, f, out);
+
+			int error = 0;
+			for (std::size_t i = 0; i < 2; ++i) {
+				hTransform expected = lerp::smoothstep(a.get(i), b.get(i), f[i]);
+				hTransform result = out.get(i);
+				if (distance(expected.position, result.position) > 0.0001_hf) error++;
+				if (distance(expected.scale, result.scale) > 0.0001_hf) error++;
+				if (std::abs(expected.rotation.tau - result.rotation.tau) > 0.0001_hf) error++;
+			}
+			Assert::AreEqual(0, error, L"Batch interpolation does not match scalar interpolation.");
+		}
+
+		TEST_METHOD(Lerp_RotationShortestPath) {
+			hRotation r = lerp::lerp(hRotation(0.9_hf), hRotation(0.1_hf), 0.5_hf);
+			Assert::AreEqual(0._hf, r.angle().tau - std::round(r.angle().tau), 0.0001_hf, L"Rotation did not wrap across zero.");
+			r = lerp::lerp(hRotation(0.0_hf), hRotation(0.75_hf), 0.5_hf);
+			Assert::AreEqual(-0.125_hf, r.tau, 0.0001_hf, L"Rotation did not take the shortest path.");
+		}
+
+		TEST_METHOD(Track_SampleWithCursor) {
+			hTransformTrack track;
+			for (int i = 0; i < 10; ++i)
+				track.add(static_cast<hType_f>(i), hTransform({ i * 2._hf, 0._hf }, hRotation(), { 1._hf, 1._hf }));
+
+			hTrackCursor cursor;
+			int error = 0;
+			for (hType_f t = 0._hf; t < 9._hf; t += 0.1_hf) {
+				hTransform sample = track.sample(t, cursor);
+				if (std::abs(sample.position.x - t * 2._hf) > 0.001_hf) error++;
+				if (cursor.key != static_cast<std::size_t>(t)) error++;
+			}
+			Assert::AreEqual(0, error, L"Linear track sampling failure.");
+
+			hTransform back = track.sample(2.5_hf, cursor);
+			Assert::AreEqual(5._hf, back.position.x, 0.001_hf, L"Sampling backwards with a cursor failed.");
+			Assert::AreEqual(18._hf, track.sample(100._hf).position.x, 0.001_hf, L"Sampling past the end failed.");
+		}
+
+		TEST_METHOD(Track_InterpolationModes) {
+			hTransformTrack track;
+			track.add(0._hf, hTransform({ 0._hf, 0._hf }, hRotation(0.9_hf), { 1._hf, 1._hf }));
+			track.add(1._hf, hTransform({ 4._hf, 0._hf }, hRotation(0.1_hf), { 1._hf, 1._hf }));
+			track.add(3._hf, hTransform({ 2._hf, 6._hf }, hRotation(0.2_hf), { 1._hf, 1._hf }));
+
+			track.mode = hInterpolation::Step;
+			Assert::AreEqual(4._hf, track.sample(2.9_hf).position.x, 0.001_hf, L"Step interpolation failure.");
+
+			track.mode = hInterpolation::Hermite;
+			Assert::AreEqual(lerp::smoothstep(0._hf, 4._hf, 0.3_hf), track.sample(0.3_hf).position.x, 0.001_hf, L"Hermite with flat tangents should match smoothstep.");
+
+			track.mode = hInterpolation::CatmullRom;
+			Assert::AreEqual(4._hf, track.sample(1._hf).position.x, 0.001_hf, L"Catmull-Rom does not pass through keyframe.");
+			hType_f tau = track.sample(0.5_hf).rotation.tau;
+			Assert::IsTrue(tau > 0.9_hf && tau < 1.1_hf, L"Catmull-Rom rotation did not take the shortest path.");
+
+			hTransformTrack tracks[2] = { track, track };
+			hTrackCursor cursors[2];
+			hType_f times[2] = { 1._hf, 3._hf };
+			hTransformBatch out;
+			sampleTracks(tracks, cursors, times, out);
+			Assert::AreEqual(6._hf, out.y[1], 0.001_hf, L"Batch track sampling failure.");
+		}
 	};
 
 
@@ -301,5 +965,210 @@ namespace hrzn
 
 		}
 
+		TEST_METHOD(Util_BoundsOverSpans) {
+			hrzn::hArea area = hrzn::makeAreaBoundary({ { 4, 7 }, { -2, 3 }, { 9, -5 } });
+			Assert::AreEqual(-2, area.x1, L"Area boundary x1.");
+			Assert::AreEqual(-5, area.y1, L"Area boundary y1.");
+			Assert::AreEqual(9, area.x2, L"Area boundary x2.");
+			Assert::AreEqual(7, area.y2, L"Area boundary y2.");
+
+			std::vector<hVector> points;
+			for (int i = 0; i < 4 * 4096; ++i)
+				points.push_back({ (hType_f)(i % 37) - 10._hf, (hType_f)(i % 53) * 0.5_hf });
+			// Extremes in the last chunk, so the parallel path has to merge the partial results of later workers
+			points.push_back({ -50._hf, 80._hf });
+			points.push_back({ 70._hf, -60._hf });
+			hBox serial = hrzn::boundingBox(std::span<const hVector>(points), SIZE_MAX);
+			hBox parallel = hrzn::boundingBox(std::span<const hVector>(points), 1);
+			Assert::AreEqual(-50._hf, serial.v1.x, 0.0001_hf, L"Box min x.");
+			Assert::AreEqual(-60._hf, serial.v1.y, 0.0001_hf, L"Box min y.");
+			Assert::AreEqual(70._hf, serial.v2.x, 0.0001_hf, L"Box max x.");
+			Assert::AreEqual(80._hf, serial.v2.y, 0.0001_hf, L"Box max y.");
+			Assert::IsTrue(serial.v1 == parallel.v1 && serial.v2 == parallel.v2, L"Parallel reduction differs from serial.");
+
+			hPolygonArena arena;
+			arena.push_back(hPolygonView(std::span<const hVector>(points).first(10)));
+			arena.push_back(hPolygonView(std::span<const hVector>()));
+			arena.push_back(hPolygonView(std::span<const hVector>(points)));
+			std::vector<hBox> boxes(arena.size());
+			hrzn::boundingBoxes(arena, boxes);
+			Assert::AreEqual(-1._hf, boxes[0].v2.x, 0.0001_hf, L"First polygon max x.");
+			Assert::AreEqual(0._hf, boxes[1].v2.x, 0.0001_hf, L"Empty polygon box.");
+			Assert::IsTrue(boxes[2].v1 == serial.v1 && boxes[2].v2 == serial.v2, L"Arena box differs from direct box.");
+		}
+
+		TEST_METHOD(Util_BatchVectorKernels) {
+			std::vector<hVector> vectors = { { 3._hf, 4._hf }, { 0._hf, 0._hf }, { -2._hf, 0._hf }, { 1._hf, 1._hf } };
+			hrzn::hVectorBatch exact(vectors);
+			hrzn::hVectorBatch fast(vectors);
+
+			std::vector<hType_f> len(vectors.size());
+			hrzn::lengths(exact, len);
+			Assert::AreEqual(5._hf, len[0], 0.0001_hf, L"Batch length.");
+
+			hrzn::normalize(exact);
+			hrzn::normalize(fast, hrzn::hAccuracy::Fast);
+			for (std::size_t i = 0; i < vectors.size(); ++i) {
+				hVector e = hrzn::getNormalized(vectors[i]);
+				Assert::AreEqual(e.x, exact.x[i], 0.0001_hf, L"Exact normalize x.");
+				Assert::AreEqual(e.y, exact.y[i], 0.0001_hf, L"Exact normalize y.");
+				Assert::AreEqual(e.x, fast.x[i], 0.0001_hf, L"Fast normalize x.");
+				Assert::AreEqual(e.y, fast.y[i], 0.0001_hf, L"Fast normalize y.");
+			}
+
+			hrzn::hVectorBatch agents, targets;
+			for (int i = 0; i < 40; ++i)
+				agents.push_back({ (hType_f)(i * 7 % 31), (hType_f)(i * 3 % 17) });
+			for (int i = 0; i < 700; ++i)
+				targets.push_back({ (hType_f)(i * 13 % 97) * 0.5_hf, (hType_f)(i * 11 % 89) * 0.25_hf });
+
+			std::vector<hType_f> matrix(agents.size() * targets.size());
+			hrzn::distanceMatrix(agents, targets, matrix);
+			std::vector<std::size_t> index(agents.size());
+			std::vector<hType_f> dist(agents.size());
+			hrzn::nearest(agents, targets, index, dist);
+
+			int error = 0;
+			for (std::size_t i = 0; i < agents.size(); ++i) {
+				std::size_t best = 0;
+				for (std::size_t j = 0; j < targets.size(); ++j) {
+					if (std::abs(matrix[i * targets.size() + j] - hrzn::distance(agents.get(i), targets.get(j))) > 0.001_hf)
+						error++;
+					if (matrix[i * targets.size() + j] < matrix[i * targets.size() + best])
+						best = j;
+				}
+				if (index[i] != best || std::abs(dist[i] - matrix[i * targets.size() + best]) > 0.001_hf)
+					error++;
+			}
+			Assert::AreEqual(0, error, L"Distance matrix or nearest target mismatch.");
+		}
+
+		TEST_METHOD(Util_BatchRotations) {
+			hrzn::hVectorBatch vectors;
+			vectors.push_back({ 0._hf, 0._hf });
+			for (int i = 0; i < 360; ++i)
+				vectors.push_back(hrzn::hRotation::Degrees((hType_f)i + 0.37_hf).getForwardVector((hType_f)(1 + i % 7)));
+
+			std::vector<hType_f> exact(vectors.size()), fast(vectors.size()), coarse(vectors.size());
+			hrzn::findRotations(vectors, exact);
+			hrzn::findRotations(vectors, fast, hrzn::hAccuracy::Fast);
+			hrzn::findRotations(vectors, coarse, hrzn::hAccuracy::Coarse);
+
+			hType_f fast_err = 0._hf, coarse_err = 0._hf;
+			for (std::size_t i = 0; i < vectors.size(); ++i) {
+				hrzn::hRotation r;
+				r.setWithVector(vectors.get(i));
+				Assert::AreEqual(r.tau, exact[i], 0.000001_hf, L"Exact path differs from setWithVector.");
+				Assert::IsTrue(fast[i] >= 0._hf && fast[i] < 1._hf && coarse[i] >= 0._hf && coarse[i] < 1._hf, L"Heading out of range.");
+				fast_err = std::max(fast_err, std::abs(hrzn::hRotation::difference(r, fast[i]).tau));
+				coarse_err = std::max(coarse_err, std::abs(hrzn::hRotation::difference(r, coarse[i]).tau));
+			}
+			Assert::IsTrue(fast_err < 0.000001_hf, L"Fast atan2 exceeds its error bound.");
+			Assert::IsTrue(coarse_err < 0.0007_hf, L"Coarse atan2 exceeds its error bound.");
+		}
+
+		TEST_METHOD(Util_StringTable) {
+			hrzn::HMap<int> map(hrzn::hArea{ -1, 0, 2, 2 }, 7);
+			map.set(0, 1, -12);
+			hrzn::hStringTableStyle style;
+			style.padding = 4;
+			style.enumerate = true;
+			const std::string expected =
+				"+-------------------+\n"
+				"|      -1   0   1   |\n"
+				"|   0   7   7   7   |\n"
+				"|   1   7 -12   7   |\n"
+				"+-------------------+\n";
+			Assert::AreEqual(expected, hrzn::toStringTable(map, style));
+
+			std::ostringstream stream;
+			hrzn::writeStringTable(stream, map, style);
+			Assert::AreEqual(expected, stream.str(), L"Stream output differs from string output.");
+
+			hrzn::HMap<float> values(hrzn::hArea{ 0, 0, 2, 1 }, 0.125f);
+			hrzn::hStringTableStyle plain{ 6 };
+			plain.top_line = plain.bottom_line = 0;
+			Assert::AreEqual(std::string("|  0.12  0.12     |\n"), hrzn::toStringTable(values, plain));
+
+			hrzn::HMap<bool> mask(hrzn::hArea{ 0, 0, 3, 1 }, false);
+			mask.set(1, 0, true);
+			const std::string colored = hrzn::toStringMask(mask, plain, [](bool v) { return v ? 1 : -1; });
+			Assert::AreEqual(std::string("|     .\x1b[38;5;1m     #\x1b[0m     .     |\n"), colored);
+		}
+
+		TEST_METHOD(Util_ParseGrids) {
+			const auto table = hrzn::makeCharTable<int>(-1, { { '.', 0 }, { '#', 1 }, { ' ', 0 } });
+			const char* art = "#.#\r\n.#\n\n###.\n";
+			hrzn::HMap<int> grid = hrzn::parseAsciiGrid(art, table, { 2, -1 });
+			Assert::AreEqual(hrzn::hArea{ 2, -1, 6, 3 }, (hrzn::hArea)grid);
+			const int expected[] = { 1, 0, 1, 0,  0, 1, 0, 0,  0, 0, 0, 0,  1, 1, 1, 0 };
+			Assert::IsTrue(std::equal(expected, expected + 16, grid.data()), L"ASCII grid cells differ.");
+
+			std::string csv;
+			for (int y = 0; y < 40; ++y) {
+				for (int x = 0; x < 25; ++x)
+					csv += std::to_string(x * 0.5 - y) + (x < 24 ? ", " : "\r\n");
+			}
+			hrzn::HMap<double> values = hrzn::parseCsvGrid<double>(csv);
+			std::istringstream stream(csv);
+			hrzn::HCsvGridParser<double> parser;
+			hrzn::forEachLine(stream, parser, 7);
+			hrzn::HMap<double> streamed = parser.build({ 0, 0 });
+			Assert::AreEqual(hrzn::hArea{ 0, 0, 25, 40 }, (hrzn::hArea)values);
+			Assert::AreEqual(hrzn::hArea{ 0, 0, 25, 40 }, (hrzn::hArea)streamed);
+			Assert::IsTrue(hrzn::compare(values, streamed), L"Block reads differ from in-memory parse.");
+			Assert::AreEqual(-39.0 + 12.0, values.at(24, 39), 1e-9);
+
+			auto bad = [] { hrzn::parseCsvGrid<int>("1,2\n3,x\n"); };
+			Assert::ExpectException<std::invalid_argument>(bad);
+			auto ragged = [] { hrzn::parseCsvGrid<int>("1,2\n3\n"); };
+			Assert::ExpectException<std::invalid_argument>(ragged);
+			auto longer = [] { hrzn::parseCsvGrid<int>("1,2\n3,4,5\n6,7,8\n"); };
+			Assert::ExpectException<std::invalid_argument>(longer);
+			auto signs = [] { hrzn::parseCsvGrid<int>("1,+-5\n"); };
+			Assert::ExpectException<std::invalid_argument>(signs);
+			Assert::AreEqual(5, hrzn::parseCsvGrid<int>(" +5 , -5\n").at(0, 0));
+		}
+
+		TEST_METHOD(Util_ImageExport) {
+			hrzn::HMap<int> map(hrzn::hArea{ -1, -1, 2, 1 }, 0);
+			map.set(-1, -1, 10);
+			map.set(0, -1, 15);
+			map.set(1, 0, 20);
+
+			std::ostringstream pgm;
+			hrzn::writePGM(pgm, map);
+			const std::string header = "P5\n3 2\n255\n";
+			Assert::AreEqual(header, pgm.str().substr(0, header.size()));
+			const unsigned char levels[] = { 127, 191, 0, 0, 0, 255 };
+			Assert::AreEqual(header.size() + 6, pgm.str().size());
+			Assert::IsTrue(std::memcmp(levels, pgm.str().data() + header.size(), 6) == 0, L"PGM levels differ.");
+
+			std::ostringstream ppm;
+			hrzn::writePPM(ppm, map, hrzn::grayPalette(), { 0.0, 20.0 });
+			const std::string pixels = ppm.str().substr(ppm.str().size() - 18);
+			Assert::AreEqual(std::string("P6\n3 2\n255\n"), ppm.str().substr(0, 11));
+			Assert::AreEqual(255, (int)(unsigned char)pixels[15]);
+			Assert::AreEqual((int)(unsigned char)pixels[0], (int)(unsigned char)pixels[2]);
+			Assert::IsTrue(hrzn::heatPalette()[0] == hrzn::hColor{ 0, 0, 0 } && hrzn::heatPalette()[255] == hrzn::hColor{ 255, 255, 255 });
+
+			hrzn::hPalette palette = hrzn::makePalette({ { 0, 0, 255 }, { 255, 0, 0 } });
+			std::ostringstream local, temporary;
+			hrzn::writePPM(local, map, palette);
+			hrzn::writePPM(temporary, map, hrzn::makePalette({ { 0, 0, 255 }, { 255, 0, 0 } }));
+			Assert::AreEqual(local.str(), temporary.str(), L"Palette passed by value differs.");
+			const std::string blue = local.str().substr(local.str().size() - 18);
+			Assert::IsTrue(blue[6] == 0 && blue[8] == (char)255 && blue[15] == (char)255 && blue[17] == 0, L"Local palette colours.");
+
+			std::ostringstream pfm;
+			hrzn::writePFM(pfm, map);
+			const std::string data = pfm.str();
+			float first = 0.f;
+			std::memcpy(&first, data.data() + data.size() - 6 * sizeof(float), sizeof(float));
+			Assert::AreEqual(0.f, first, L"PFM rows must be stored bottom up.");
+			std::memcpy(&first, data.data() + data.size() - 3 * sizeof(float), sizeof(float));
+			Assert::AreEqual(10.f, first);
+		}
+
 	};
 }